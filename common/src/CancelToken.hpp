@@ -0,0 +1,27 @@
+#ifndef CANCEL_TOKEN_HPP
+#define CANCEL_TOKEN_HPP
+
+#include <atomic>
+#include <cstdint>
+
+// Lets a long-running search notice that its answer is no longer wanted.
+//
+// The token remembers the value an epoch counter had when the work started;
+// whoever owns the counter bumps it to cancel. Searches poll cancelled()
+// every few hundred items and return early, leaving their output partial.
+// A default-constructed token is never cancelled.
+class CancelToken {
+  public:
+    CancelToken() = default;
+    CancelToken(const std::atomic<uint64_t>& epoch, uint64_t started) : m_epoch(&epoch), m_started(started) {}
+
+    bool cancelled() const {
+        return m_epoch && m_epoch->load(std::memory_order_relaxed) != m_started;
+    }
+
+  private:
+    const std::atomic<uint64_t>* m_epoch = nullptr;
+    uint64_t m_started = 0;
+};
+
+#endif // CANCEL_TOKEN_HPP
@@ -0,0 +1,81 @@
+#ifndef DESKTOP_ENTRY_LINES_HPP
+#define DESKTOP_ENTRY_LINES_HPP
+
+#include <cstddef>
+#include <string_view>
+
+// Tokenizer for the [Desktop Entry] group of a .desktop file, shared by
+// the launchers' parsers.
+//
+// It works in place on string_views and copies nothing. Comments are whole
+// lines starting with '#', as the spec defines them, so a '#' inside a
+// value is preserved. The group ends at the next group header, since
+// actions and other groups are never used.
+namespace DesktopEntryLines {
+
+inline constexpr std::string_view GROUP = "[Desktop Entry]";
+
+inline std::string_view trim(std::string_view str) {
+    size_t first = str.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) return {};
+    size_t last = str.find_last_not_of(" \t\r");
+    return str.substr(first, last - first + 1);
+}
+
+// Calls fn(line) with each trimmed line of `data` that is neither blank
+// nor a comment, until fn returns false. A last line without a newline
+// counts, so the data may end partway through one.
+template <typename Fn>
+void forEachLine(std::string_view data, Fn&& fn) {
+    while (!data.empty()) {
+        size_t eol = data.find('\n');
+        std::string_view line = trim(data.substr(0, eol));
+        data = eol == std::string_view::npos ? std::string_view{} : data.substr(eol + 1);
+
+        if (line.empty() || line.front() == '#') continue;
+        if (!fn(line)) return;
+    }
+}
+
+// Calls fn(key, value), both trimmed, for each key of the [Desktop Entry]
+// group. Returns the offset of its header in `data`, or npos if there is
+// no such group.
+template <typename Fn>
+size_t forEachEntry(std::string_view data, Fn&& fn) {
+    size_t header = std::string_view::npos;
+    bool inGroup = false;
+    forEachLine(data, [&](std::string_view line) {
+        if (line.front() == '[') {
+            if (inGroup) return false;
+            inGroup = line == GROUP;
+            if (inGroup) header = static_cast<size_t>(line.data() - data.data());
+            return true;
+        }
+        if (!inGroup) return true;
+
+        size_t equalsPos = line.find('=');
+        if (equalsPos != std::string_view::npos) {
+            fn(trim(line.substr(0, equalsPos)), trim(line.substr(equalsPos + 1)));
+        }
+        return true;
+    });
+    return header;
+}
+
+// Whether `data` reaches the header that ends the [Desktop Entry] group,
+// so nothing after it can matter to forEachEntry()
+inline bool reachesGroupEnd(std::string_view data) {
+    bool inGroup = false;
+    bool ended = false;
+    forEachLine(data, [&](std::string_view line) {
+        if (line.front() != '[') return true;
+        ended = inGroup;
+        inGroup = line == GROUP;
+        return !ended;
+    });
+    return ended;
+}
+
+} // namespace DesktopEntryLines
+
+#endif // DESKTOP_ENTRY_LINES_HPP
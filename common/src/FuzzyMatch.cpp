@@ -0,0 +1,251 @@
+#include "FuzzyMatch.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// Scores as in fzf, so results rank the way its users expect
+constexpr int SCORE_MATCH = 16;
+constexpr int GAP_START = -3;
+constexpr int GAP_EXTENSION = -1;
+constexpr int BONUS_BOUNDARY = SCORE_MATCH / 2;
+constexpr int BONUS_BOUNDARY_WHITE = BONUS_BOUNDARY + 2;
+constexpr int BONUS_BOUNDARY_DELIMITER = BONUS_BOUNDARY + 1;
+constexpr int BONUS_NON_WORD = SCORE_MATCH / 2;
+constexpr int BONUS_CAMEL = BONUS_BOUNDARY + GAP_EXTENSION;
+// Enough that a run beats the same bytes with a gap between them
+constexpr int BONUS_CONSECUTIVE = -(GAP_START + GAP_EXTENSION);
+constexpr int FIRST_CHAR_MULTIPLIER = 2;
+// Largest bonus any byte can earn, from bonusFor() or a run it extends
+constexpr int MAX_BONUS = std::max({BONUS_BOUNDARY_WHITE, BONUS_BOUNDARY_DELIMITER, BONUS_BOUNDARY, BONUS_NON_WORD,
+                                    BONUS_CAMEL, BONUS_CONSECUTIVE});
+
+constexpr int UNREACHABLE = INT_MIN / 2;
+
+enum class CharClass {
+    WHITE,
+    DELIMITER,
+    NON_WORD,
+    LOWER,
+    UPPER,
+    // Bytes of multi-byte UTF-8 sequences
+    LETTER,
+    DIGIT,
+};
+
+constexpr CharClass classify(unsigned char c) {
+    if (c >= 'a' && c <= 'z') return CharClass::LOWER;
+    if (c >= 'A' && c <= 'Z') return CharClass::UPPER;
+    if (c >= '0' && c <= '9') return CharClass::DIGIT;
+    if (c >= 0x80) return CharClass::LETTER;
+    if (c == ' ' || c == '\t') return CharClass::WHITE;
+    if (c == '/' || c == ',' || c == ':' || c == ';' || c == '|') return CharClass::DELIMITER;
+    return CharClass::NON_WORD;
+}
+
+constexpr bool isWord(CharClass cls) {
+    return cls == CharClass::LOWER || cls == CharClass::UPPER || cls == CharClass::LETTER ||
+           cls == CharClass::DIGIT;
+}
+
+constexpr int bonusFor(CharClass prev, CharClass cls) {
+    if (isWord(cls)) {
+        if (prev == CharClass::WHITE) return BONUS_BOUNDARY_WHITE;
+        if (prev == CharClass::DELIMITER) return BONUS_BOUNDARY_DELIMITER;
+        if (prev == CharClass::NON_WORD) return BONUS_BOUNDARY;
+    }
+    if ((prev == CharClass::LOWER && cls == CharClass::UPPER) ||
+        (prev != CharClass::DIGIT && cls == CharClass::DIGIT)) {
+        return BONUS_CAMEL;
+    }
+    if (cls == CharClass::WHITE) return BONUS_BOUNDARY_WHITE;
+    if (cls == CharClass::DELIMITER || cls == CharClass::NON_WORD) return BONUS_NON_WORD;
+    return 0;
+}
+
+constexpr size_t CLASS_COUNT = static_cast<size_t>(CharClass::DIGIT) + 1;
+
+struct Tables {
+    CharClass classes[256] = {};
+    int8_t bonus[CLASS_COUNT][CLASS_COUNT] = {};
+};
+
+// Both lookups run for every byte of every scored key
+constexpr Tables TABLES = [] {
+    Tables tables;
+    for (size_t c = 0; c < 256; ++c) {
+        tables.classes[c] = classify(static_cast<unsigned char>(c));
+    }
+    for (size_t prev = 0; prev < CLASS_COUNT; ++prev) {
+        for (size_t cls = 0; cls < CLASS_COUNT; ++cls) {
+            tables.bonus[prev][cls] = static_cast<int8_t>(
+                bonusFor(static_cast<CharClass>(prev), static_cast<CharClass>(cls)));
+        }
+    }
+    return tables;
+}();
+
+CharClass classOf(char c) {
+    return TABLES.classes[static_cast<unsigned char>(c)];
+}
+
+int bonusAt(std::string_view classes, size_t pos) {
+    const CharClass prev = pos == 0 ? CharClass::WHITE : classOf(classes[pos - 1]);
+    return TABLES.bonus[static_cast<size_t>(prev)][static_cast<size_t>(classOf(classes[pos]))];
+}
+
+// Per-thread DP rows, so a warmed-up search does not allocate
+struct Scratch {
+    std::vector<int> bonus;
+    std::vector<int> score[2];
+    std::vector<int> run[2];
+    // Per pattern byte, the first and last key position it can match at
+    std::vector<size_t> low;
+    std::vector<size_t> high;
+};
+
+} // namespace
+
+namespace FuzzyMatch {
+
+int maxScore(size_t length) {
+    // Every byte matched with the largest bonus, no gaps, the first one's
+    // bonus multiplied
+    return static_cast<int>(length) * (SCORE_MATCH + MAX_BONUS) + MAX_BONUS * (FIRST_CHAR_MULTIPLIER - 1);
+}
+
+uint64_t charMask(std::string_view key) {
+    uint64_t mask = 0;
+    for (char ch : key) {
+        const unsigned char c = static_cast<unsigned char>(ch);
+        unsigned bit;
+        if (c >= 'a' && c <= 'z') {
+            bit = c - 'a';
+        } else if (c >= '0' && c <= '9') {
+            bit = 26 + (c - '0');
+        } else {
+            // Everything else shares the remaining 28 bits
+            bit = 36 + c % 28;
+        }
+        mask |= uint64_t{1} << bit;
+    }
+    return mask;
+}
+
+bool matches(std::string_view key, std::string_view pattern) {
+    const char* pos = key.data();
+    const char* end = key.data() + key.size();
+    for (char c : pattern) {
+        pos = static_cast<const char*>(std::memchr(pos, c, static_cast<size_t>(end - pos)));
+        if (!pos) return false;
+        ++pos;
+    }
+    return true;
+}
+
+int score(std::string_view key, std::string_view pattern, std::string_view text) {
+    const size_t m = pattern.size();
+    if (m == 0) return 0;
+    if (m > key.size()) return NO_MATCH;
+
+    // Case survives only in the original text, when the key kept its layout
+    const std::string_view classes = text.size() == key.size() ? text : key;
+
+    // One byte: the best occurrence is the one with the highest bonus
+    if (m == 1) {
+        int best = -1;
+        for (size_t pos = key.find(pattern[0]); pos != std::string_view::npos;
+             pos = key.find(pattern[0], pos + 1)) {
+            best = std::max(best, bonusAt(classes, pos));
+        }
+        return best < 0 ? NO_MATCH : SCORE_MATCH + best * FIRST_CHAR_MULTIPLIER;
+    }
+
+    thread_local Scratch scratch;
+    scratch.low.resize(m);
+    scratch.high.resize(m);
+
+    // Pattern byte i can only match between where the earliest alignment
+    // puts it and where the latest one does
+    size_t pos = 0;
+    for (size_t i = 0; i < m; ++i, ++pos) {
+        pos = key.find(pattern[i], pos);
+        if (pos == std::string_view::npos) return NO_MATCH;
+        scratch.low[i] = pos;
+    }
+    pos = key.size();
+    for (size_t i = m; i-- > 0;) {
+        pos = key.rfind(pattern[i], pos - 1);
+        scratch.high[i] = pos;
+    }
+
+    const size_t first = scratch.low[0];
+    const size_t width = scratch.high[m - 1] + 1 - first;
+    scratch.bonus.resize(width);
+    for (auto* rows : {scratch.score, scratch.run}) {
+        rows[0].resize(width);
+        rows[1].resize(width);
+    }
+    for (size_t j = 0; j < width; ++j) {
+        scratch.bonus[j] = bonusAt(classes, first + j);
+    }
+
+    // score[i][j]: best alignment of pattern[0..i] with pattern[i] at key[first + j]
+    // run[i][j]: bonus of the consecutive run that alignment ends in.
+    // Row i is only meaningful within [low[i], high[i]].
+    for (size_t j = 0; j <= scratch.high[0] - first; ++j) {
+        const bool hit = key[first + j] == pattern[0];
+        scratch.score[0][j] = hit ? SCORE_MATCH + scratch.bonus[j] * FIRST_CHAR_MULTIPLIER : UNREACHABLE;
+        scratch.run[0][j] = scratch.bonus[j];
+    }
+
+    for (size_t i = 1; i < m; ++i) {
+        const auto& prevScore = scratch.score[(i - 1) & 1];
+        const auto& prevRun = scratch.run[(i - 1) & 1];
+        auto& curScore = scratch.score[i & 1];
+        auto& curRun = scratch.run[i & 1];
+
+        const size_t prevLow = scratch.low[i - 1] - first;
+        const size_t prevHigh = scratch.high[i - 1] - first;
+        const size_t low = scratch.low[i] - first;
+        const size_t high = scratch.high[i] - first;
+
+        // Best earlier alignment reaching j across a gap of at least one byte
+        int carried = UNREACHABLE;
+        for (size_t j = prevLow + 1; j <= high; ++j) {
+            if (j >= prevLow + 2) {
+                const int opened = j - 2 <= prevHigh ? prevScore[j - 2] + GAP_START : UNREACHABLE;
+                carried = std::max(carried + GAP_EXTENSION, opened);
+            }
+            if (j < low) continue;
+
+            curScore[j] = UNREACHABLE;
+            if (key[first + j] != pattern[i]) continue;
+
+            int best = carried > UNREACHABLE ? carried + SCORE_MATCH + scratch.bonus[j] : UNREACHABLE;
+            int bestRun = scratch.bonus[j];
+
+            if (j - 1 <= prevHigh && prevScore[j - 1] > UNREACHABLE) {
+                const int runBonus = std::max({scratch.bonus[j], prevRun[j - 1], BONUS_CONSECUTIVE});
+                const int extended = prevScore[j - 1] + SCORE_MATCH + runBonus;
+                if (extended >= best) {
+                    best = extended;
+                    bestRun = runBonus;
+                }
+            }
+
+            curScore[j] = best;
+            curRun[j] = bestRun;
+        }
+    }
+
+    const auto& last = scratch.score[(m - 1) & 1];
+    const auto begin = last.begin() + static_cast<ptrdiff_t>(scratch.low[m - 1] - first);
+    const int best = *std::max_element(begin, last.begin() + static_cast<ptrdiff_t>(width));
+    return best > UNREACHABLE ? best : NO_MATCH;
+}
+
+} // namespace FuzzyMatch
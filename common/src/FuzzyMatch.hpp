@@ -0,0 +1,48 @@
+#ifndef FUZZY_MATCH_HPP
+#define FUZZY_MATCH_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// fzf-style fuzzy matching over SearchKeys.
+//
+// A pattern matches when its bytes appear in the key in order, so "ffx"
+// finds "firefox" and "vsc" finds "visual studio code". Matches are scored
+// by the best alignment: every matched byte earns a base score, bytes at a
+// word start, a camelCase hump or a digit run earn a bonus (the first
+// pattern byte twice over, so prefixes rank highest), consecutive bytes
+// keep the bonus of the run they extend, and gaps between matched bytes
+// cost a little per skipped byte.
+//
+// Before any of that, a 64-bit mask of the byte classes in each key rejects
+// most non-matches with one AND.
+namespace FuzzyMatch {
+
+// Returned by score() when the pattern does not match. Long gaps can push
+// real scores below zero.
+constexpr int NO_MATCH = INT_MIN;
+
+// Set of byte classes present in `key`. A pattern can only match keys whose
+// mask contains the pattern's mask; the converse does not hold.
+uint64_t charMask(std::string_view key);
+
+inline bool mayMatch(uint64_t keyMask, uint64_t patternMask) {
+    return (keyMask & patternMask) == patternMask;
+}
+
+// Whether `pattern` is a subsequence of `key`
+bool matches(std::string_view key, std::string_view pattern);
+
+// No alignment of a pattern of `length` bytes scores higher than this
+int maxScore(size_t length);
+
+// Score of the best alignment of `pattern` in `key`, or NO_MATCH. `text` is
+// the string the key was made from; when it lines up with the key byte for
+// byte its case is used for camelCase bonuses. An empty pattern scores 0.
+int score(std::string_view key, std::string_view pattern, std::string_view text = {});
+
+} // namespace FuzzyMatch
+
+#endif // FUZZY_MATCH_HPP
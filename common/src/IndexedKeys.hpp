@@ -0,0 +1,125 @@
+#ifndef INDEXED_KEYS_HPP
+#define INDEXED_KEYS_HPP
+
+#include "CancelToken.hpp"
+#include "PackedKeys.hpp"
+#include "SubstringScan.hpp"
+#include "TrigramIndex.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Search keys of a collection that may grow to hundreds of thousands of
+// items, such as a photo library.
+//
+// Small collections are searched with one scan over the packed keys. Once
+// the collection reaches the index threshold, a TrigramIndex is built over
+// what is there and kept up to date by later appends, and needles of three
+// bytes or more only verify the keys their trigrams point at. Shorter
+// needles match too much of the collection for an index to help and keep
+// scanning.
+class IndexedKeys {
+  public:
+    static constexpr size_t DEFAULT_INDEX_THRESHOLD = 20000;
+
+    // $HYPRLAND_TOOLS_INDEX_THRESHOLD if set, else DEFAULT_INDEX_THRESHOLD.
+    // 0 indexes every collection.
+    static size_t defaultThreshold() {
+        const char* env = std::getenv("HYPRLAND_TOOLS_INDEX_THRESHOLD");
+        if (!env || !*env) return DEFAULT_INDEX_THRESHOLD;
+
+        char* end = nullptr;
+        const unsigned long long value = std::strtoull(env, &end, 10);
+        return *end == '\0' ? static_cast<size_t>(value) : DEFAULT_INDEX_THRESHOLD;
+    }
+
+    explicit IndexedKeys(size_t indexThreshold = defaultThreshold()) : m_threshold(indexThreshold) {}
+
+    void clear() {
+        m_keys.clear();
+        m_trigrams.clear();
+        m_indexed = false;
+    }
+
+    // Add the key of item size()
+    void append(std::string_view key) {
+        const size_t id = m_keys.size();
+        m_keys.append(key);
+
+        if (m_indexed) {
+            m_trigrams.add(static_cast<uint32_t>(id), key);
+        } else if (m_keys.size() >= m_threshold) {
+            buildIndex();
+        }
+    }
+
+    size_t size() const { return m_keys.size(); }
+    std::string_view key(size_t index) const { return m_keys.key(index); }
+
+    bool indexed() const { return m_indexed; }
+    const TrigramIndex& trigrams() const { return m_trigrams; }
+
+    // Fill `out` with the ascending indices of the keys containing `needle`.
+    // Once `cancel` fires, this returns with `out` incomplete.
+    void find(std::string_view needle, std::vector<size_t>& out, const CancelToken& cancel = {}) const {
+        out.clear();
+        if (indexedCandidates(needle)) {
+            for (size_t i = 0; i < m_candidates.size(); ++i) {
+                if (i % CANCEL_CHECK_INTERVAL == 0 && cancel.cancelled()) return;
+                if (SubstringScan::contains(m_keys.key(m_candidates[i]), needle)) out.push_back(m_candidates[i]);
+            }
+            return;
+        }
+
+        m_keys.forEachMatch(needle, [&](size_t index) { out.push_back(index); });
+    }
+
+    // Same over ascending `candidates` only; `out` must not alias them
+    void refine(std::string_view needle, std::span<const size_t> candidates, std::vector<size_t>& out,
+                const CancelToken& cancel = {}) const {
+        out.clear();
+
+        // Both lists are ascending, so the trigram candidates narrow the
+        // earlier matches with one merge before any key is read
+        const bool indexed = indexedCandidates(needle);
+        auto it = m_candidates.begin();
+
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (i % CANCEL_CHECK_INTERVAL == 0 && cancel.cancelled()) return;
+
+            const size_t index = candidates[i];
+            if (indexed) {
+                while (it != m_candidates.end() && *it < index) ++it;
+                if (it == m_candidates.end()) break;
+                if (*it != index) continue;
+            }
+            if (SubstringScan::contains(m_keys.key(index), needle)) out.push_back(index);
+        }
+    }
+
+  private:
+    // Keys verified between two looks at the cancel token
+    static constexpr size_t CANCEL_CHECK_INTERVAL = 512;
+
+    void buildIndex() {
+        // Keys go in ascending order, so every posting list is appended to
+        for (size_t index = 0; index < m_keys.size(); ++index) {
+            m_trigrams.add(static_cast<uint32_t>(index), m_keys.key(index));
+        }
+        m_indexed = true;
+    }
+
+    bool indexedCandidates(std::string_view needle) const {
+        return m_indexed && m_trigrams.candidates(needle, m_candidates);
+    }
+
+    PackedKeys m_keys;
+    TrigramIndex m_trigrams;
+    size_t m_threshold;
+    bool m_indexed = false;
+    mutable std::vector<uint32_t> m_candidates;
+};
+
+#endif // INDEXED_KEYS_HPP
@@ -0,0 +1,74 @@
+#ifndef PACKED_KEYS_HPP
+#define PACKED_KEYS_HPP
+
+#include "SubstringScan.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Search keys packed back to back into one buffer, each followed by a '\0',
+// plus a table of where each one ends.
+//
+// A search runs the substring kernel across the whole buffer once instead
+// of starting it per key, so the vector loop sees long runs instead of
+// 20-byte names. Match positions come out in ascending order and are mapped
+// to keys by walking the end table alongside them.
+class PackedKeys {
+  public:
+    void clear() {
+        m_data.clear();
+        m_ends.clear();
+    }
+
+    void reserve(size_t keys, size_t bytes) {
+        m_data.reserve(bytes + keys);
+        m_ends.reserve(keys);
+    }
+
+    void append(std::string_view key) {
+        m_data.append(key);
+        m_ends.push_back(static_cast<uint32_t>(m_data.size()));
+        m_data.push_back('\0');
+    }
+
+    size_t size() const { return m_ends.size(); }
+
+    std::string_view key(size_t index) const {
+        const size_t start = index == 0 ? 0 : m_ends[index - 1] + 1;
+        return {m_data.data() + start, m_ends[index] - start};
+    }
+
+    // Call fn(index) for every key containing `needle`, in ascending order
+    template <typename Fn>
+    void forEachMatch(std::string_view needle, Fn fn) const {
+        if (needle.empty()) {
+            for (size_t index = 0; index < m_ends.size(); ++index) fn(index);
+            return;
+        }
+
+        size_t index = 0;
+        size_t pos = 0;
+        while ((pos = SubstringScan::find(m_data, needle, pos)) != std::string_view::npos) {
+            while (m_ends[index] < pos) ++index;
+
+            // A needle holding '\0' could run into the next key
+            if (pos + needle.size() > m_ends[index]) {
+                ++pos;
+                continue;
+            }
+
+            fn(index);
+
+            // One match per key is enough; resume at the next one
+            pos = m_ends[index] + 1;
+            if (++index == m_ends.size()) break;
+        }
+    }
+
+  private:
+    std::string m_data;
+    std::vector<uint32_t> m_ends;
+};
+
+#endif // PACKED_KEYS_HPP
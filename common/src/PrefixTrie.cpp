@@ -0,0 +1,82 @@
+#include "PrefixTrie.hpp"
+#include <algorithm>
+
+void PrefixTrie::clear() {
+    m_nodes.clear();
+    m_entries.clear();
+    m_pendingText.clear();
+    m_pending.clear();
+}
+
+void PrefixTrie::add(std::string_view term, uint32_t id, uint8_t tag) {
+    m_pending.push_back({static_cast<uint32_t>(m_pendingText.size()), static_cast<uint32_t>(term.size()), {id, tag}});
+    m_pendingText.append(term);
+}
+
+void PrefixTrie::build() {
+    std::sort(m_pending.begin(), m_pending.end(), [&](const PendingTerm& a, const PendingTerm& b) {
+        const int order = pendingText(a).compare(pendingText(b));
+        if (order != 0) return order < 0;
+        if (a.entry.id != b.entry.id) return a.entry.id < b.entry.id;
+        return a.entry.tag < b.entry.tag;
+    });
+    m_pending.erase(std::unique(m_pending.begin(), m_pending.end(),
+                                [&](const PendingTerm& a, const PendingTerm& b) {
+                                    return a.entry == b.entry && pendingText(a) == pendingText(b);
+                                }),
+                    m_pending.end());
+
+    m_entries.clear();
+    m_entries.reserve(m_pending.size());
+    for (const auto& term : m_pending) {
+        m_entries.push_back(term.entry);
+    }
+
+    m_nodes.clear();
+    m_nodes.push_back({0, 0, static_cast<uint32_t>(m_entries.size()), 0, 0});
+    buildChildren(0, 0);
+
+    m_pendingText.clear();
+    m_pendingText.shrink_to_fit();
+    m_pending.clear();
+    m_pending.shrink_to_fit();
+}
+
+void PrefixTrie::buildChildren(uint32_t node, size_t depth) {
+    // Terms ending here sort first; the rest group by their next byte
+    uint32_t pos = m_nodes[node].begin;
+    const uint32_t end = m_nodes[node].end;
+    while (pos < end && pendingText(m_pending[pos]).size() == depth) ++pos;
+
+    const auto firstChild = static_cast<uint32_t>(m_nodes.size());
+    while (pos < end) {
+        const char byte = pendingText(m_pending[pos])[depth];
+        const uint32_t groupBegin = pos;
+        while (pos < end && pendingText(m_pending[pos])[depth] == byte) ++pos;
+        m_nodes.push_back({0, groupBegin, pos, 0, static_cast<uint8_t>(byte)});
+    }
+
+    const auto childCount = static_cast<uint32_t>(m_nodes.size()) - firstChild;
+    m_nodes[node].firstChild = firstChild;
+    m_nodes[node].childCount = static_cast<uint16_t>(childCount);
+
+    for (uint32_t child = firstChild; child < firstChild + childCount; ++child) {
+        buildChildren(child, depth + 1);
+    }
+}
+
+std::span<const PrefixTrie::Entry> PrefixTrie::find(std::string_view prefix) const {
+    if (m_nodes.empty()) return {};
+
+    const Node* node = &m_nodes[0];
+    for (char c : prefix) {
+        const Node* first = m_nodes.data() + node->firstChild;
+        const Node* last = first + node->childCount;
+        const auto byte = static_cast<uint8_t>(c);
+        const Node* child = std::lower_bound(first, last, byte,
+                                             [](const Node& n, uint8_t value) { return n.byte < value; });
+        if (child == last || child->byte != byte) return {};
+        node = child;
+    }
+    return {m_entries.data() + node->begin, node->end - node->begin};
+}
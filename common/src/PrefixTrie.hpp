@@ -0,0 +1,73 @@
+#ifndef PREFIX_TRIE_HPP
+#define PREFIX_TRIE_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Read-only trie from short terms (words, initials) to the IDs they were
+// added for, answering "which IDs have a term starting with this prefix".
+//
+// Terms are collected with add() and laid out by build(). The entries are
+// then sorted by term, so every trie node covers one contiguous run of
+// them, and a node stores only that run and where its children start;
+// children of a node sit next to each other, ordered by byte. A lookup
+// walks one node per byte of the prefix and hands back the run, so its
+// cost depends on the prefix length, not on how many terms there are. The
+// term text itself is dropped after build().
+class PrefixTrie {
+  public:
+    struct Entry {
+        uint32_t id;
+        // Caller-defined, to tell kinds of terms apart
+        uint8_t tag;
+
+        bool operator==(const Entry&) const = default;
+    };
+
+    void clear();
+
+    // Queue `term` for `id`; takes effect at the next build()
+    void add(std::string_view term, uint32_t id, uint8_t tag = 0);
+    // Replace the trie with the terms added since the last build()
+    void build();
+
+    // Entries of every term that starts with `prefix`, each (term, entry)
+    // pair once; the same entry may appear under several terms. Valid
+    // until the next build() or clear().
+    std::span<const Entry> find(std::string_view prefix) const;
+
+    size_t nodeCount() const { return m_nodes.size(); }
+    size_t entryCount() const { return m_entries.size(); }
+
+  private:
+    struct Node {
+        uint32_t firstChild = 0;
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        uint16_t childCount = 0;
+        uint8_t byte = 0;
+    };
+
+    struct PendingTerm {
+        uint32_t offset;
+        uint32_t length;
+        Entry entry;
+    };
+
+    std::string_view pendingText(const PendingTerm& term) const {
+        return {m_pendingText.data() + term.offset, term.length};
+    }
+    // Fill in the children of `node`, whose terms share their first `depth` bytes
+    void buildChildren(uint32_t node, size_t depth);
+
+    std::vector<Node> m_nodes;
+    std::vector<Entry> m_entries;
+
+    std::string m_pendingText;
+    std::vector<PendingTerm> m_pending;
+};
+
+#endif // PREFIX_TRIE_HPP
@@ -0,0 +1,128 @@
+#ifndef QUERY_CACHE_HPP
+#define QUERY_CACHE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Least-recently-used map from normalized queries to their final results.
+//
+// The same handful of queries comes up all day, and backspacing repeats the
+// ones just typed; a hit hands back the stored results without matching or
+// ranking anything. The cache is bounded both by entry count and by the
+// total number of IDs held, so a few queries matching most of a large
+// collection cannot pin much memory. The owner clears it whenever the
+// searched items change.
+//
+// Evicted and cleared entries are kept aside with their buffers and index
+// node, and the next insert() refills one, so a warmed-up cache stores a
+// miss without allocating. Buffers larger than an even share of the ID
+// budget are released instead, which keeps what is held within twice it.
+template <typename Id>
+class QueryCache {
+  public:
+    static constexpr size_t DEFAULT_MAX_ENTRIES = 64;
+    static constexpr size_t DEFAULT_MAX_IDS = 1 << 20;
+
+    explicit QueryCache(size_t maxEntries = DEFAULT_MAX_ENTRIES, size_t maxIds = DEFAULT_MAX_IDS)
+        : m_maxEntries(maxEntries), m_maxIds(maxIds) {
+        m_spareNodes.reserve(maxEntries);
+    }
+
+    // Results stored for `key`, now the most recently used, or nullptr.
+    // Valid until the next insert() or clear().
+    const std::vector<Id>* find(std::string_view key) {
+        ++m_lookups;
+        auto it = m_index.find(key);
+        if (it == m_index.end()) return nullptr;
+
+        ++m_hits;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return &it->second->results;
+    }
+
+    // Store `results` for `key`, which must not be cached yet, evicting the
+    // least recently used entries to stay within bounds. Sets larger than
+    // the whole ID budget are not kept.
+    void insert(std::string_view key, const std::vector<Id>& results) {
+        if (m_maxEntries == 0 || results.size() > m_maxIds) return;
+
+        while (!m_entries.empty() && (m_entries.size() >= m_maxEntries || m_ids + results.size() > m_maxIds)) {
+            evictOldest();
+        }
+
+        if (m_spare.empty()) {
+            m_entries.emplace_front();
+        } else {
+            m_entries.splice(m_entries.begin(), m_spare, m_spare.begin());
+        }
+        Entry& entry = m_entries.front();
+        entry.key.assign(key);
+        entry.results.assign(results.begin(), results.end());
+        m_ids += results.size();
+
+        if (m_spareNodes.empty()) {
+            m_index.emplace(entry.key, m_entries.begin());
+        } else {
+            auto node = std::move(m_spareNodes.back());
+            m_spareNodes.pop_back();
+            node.key() = entry.key;
+            node.mapped() = m_entries.begin();
+            m_index.insert(std::move(node));
+        }
+    }
+
+    void clear() {
+        while (!m_entries.empty()) {
+            evictOldest();
+        }
+    }
+
+    size_t size() const { return m_entries.size(); }
+
+    // Counted since construction, across clear()
+    uint64_t lookups() const { return m_lookups; }
+    uint64_t hits() const { return m_hits; }
+    double hitRate() const { return m_lookups ? static_cast<double>(m_hits) / static_cast<double>(m_lookups) : 0; }
+
+  private:
+    struct Entry {
+        std::string key;
+        std::vector<Id> results;
+    };
+
+    using Index = std::unordered_map<std::string_view, typename std::list<Entry>::iterator>;
+
+    void evictOldest() {
+        Entry& oldest = m_entries.back();
+        m_ids -= oldest.results.size();
+        m_spareNodes.push_back(m_index.extract(oldest.key));
+        if (oldest.results.capacity() > m_maxIds / std::max<size_t>(m_maxEntries, 1)) {
+            std::vector<Id>().swap(oldest.results);
+        }
+        m_spare.splice(m_spare.begin(), m_entries, std::prev(m_entries.end()));
+    }
+
+    size_t m_maxEntries;
+    size_t m_maxIds;
+
+    // Most recently used first; list nodes never move, so the index can
+    // key on views of their strings
+    std::list<Entry> m_entries;
+    Index m_index;
+    size_t m_ids = 0;
+
+    // Evicted entries and their index nodes, ready for reuse
+    std::list<Entry> m_spare;
+    std::vector<typename Index::node_type> m_spareNodes;
+
+    uint64_t m_lookups = 0;
+    uint64_t m_hits = 0;
+};
+
+#endif // QUERY_CACHE_HPP
@@ -0,0 +1,82 @@
+#ifndef REFINEMENT_STACK_HPP
+#define REFINEMENT_STACK_HPP
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Result sets of the queries typed so far, each extending the one below it.
+//
+// For substring search, the matches of "fire" are a subset of the matches
+// of "fir", so a query that extends the previous one only has to test the
+// previous results. Backspace walks back down the stack and finds the
+// shorter query's results already computed.
+//
+// Entries are kept in a deque so the set a search reads from stays put while
+// the next one is pushed, and popped entries keep their buffers for reuse.
+template <typename Id>
+class RefinementStack {
+  public:
+    struct Lookup {
+        // Narrowest cached set the query's matches are a subset of, or
+        // nullptr if the search has to start from everything
+        const std::vector<Id>* candidates = nullptr;
+        // candidates already is the answer for this exact query
+        bool exact = false;
+    };
+
+    // Pop every set whose query is not a prefix of `query`
+    Lookup lookup(std::string_view query) {
+        while (m_depth > 0 && !query.starts_with(m_entries[m_depth - 1].query)) {
+            --m_depth;
+        }
+        if (m_depth == 0) return {};
+
+        const Entry& top = m_entries[m_depth - 1];
+        return {&top.results, top.query.size() == query.size()};
+    }
+
+    // Start a new top entry for `query`, which must extend the current top.
+    // Fill the returned vector with its results; the set lookup() returned
+    // stays valid meanwhile.
+    std::vector<Id>& push(std::string_view query) {
+        if (m_depth == MAX_DEPTH) {
+            // Pasted text can get long; forget the shortest queries first
+            m_entries.pop_front();
+            --m_depth;
+        }
+        if (m_depth == m_entries.size()) {
+            m_entries.emplace_back();
+        }
+
+        Entry& entry = m_entries[m_depth++];
+        entry.query.assign(query);
+        entry.results.clear();
+        return entry.results;
+    }
+
+    // Drop the top entry, e.g. when filling it was cancelled halfway
+    void pop() {
+        if (m_depth > 0) --m_depth;
+    }
+
+    // Forget every set, e.g. after the searched items changed
+    void clear() { m_depth = 0; }
+
+    size_t depth() const { return m_depth; }
+
+  private:
+    static constexpr size_t MAX_DEPTH = 64;
+
+    struct Entry {
+        std::string query;
+        std::vector<Id> results;
+    };
+
+    std::deque<Entry> m_entries;
+    size_t m_depth = 0;
+};
+
+#endif // REFINEMENT_STACK_HPP
@@ -0,0 +1,102 @@
+#include "SearchKey.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+namespace {
+
+#include "SearchKeyTable.inc"
+
+static_assert(std::size(KEY_OFFSETS) == std::size(KEY_CODEPOINTS) + 1);
+
+// Combining diacritical mark blocks; must match gen_search_key_table.py
+bool isDiacritic(uint32_t cp) {
+    return (cp >= 0x0300 && cp <= 0x036F) || (cp >= 0x1AB0 && cp <= 0x1AFF) ||
+           (cp >= 0x1DC0 && cp <= 0x1DFF) || (cp >= 0x20D0 && cp <= 0x20FF) ||
+           (cp >= 0xFE20 && cp <= 0xFE2F);
+}
+
+// Decode one UTF-8 sequence at the start of `text`. Returns its length, or
+// 0 if it is malformed (overlong forms and surrogates included).
+size_t decode(std::string_view text, uint32_t& cp) {
+    const auto byte = [&](size_t i) { return static_cast<unsigned char>(text[i]); };
+    const unsigned char lead = byte(0);
+
+    size_t length;
+    uint32_t min;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+        min = 0x80;
+        cp = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        min = 0x800;
+        cp = lead & 0x0F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        min = 0x10000;
+        cp = lead & 0x07;
+    } else {
+        return 0;
+    }
+
+    if (text.size() < length) return 0;
+    for (size_t i = 1; i < length; ++i) {
+        if ((byte(i) & 0xC0) != 0x80) return 0;
+        cp = (cp << 6) | (byte(i) & 0x3F);
+    }
+
+    if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return 0;
+    return length;
+}
+
+} // namespace
+
+namespace SearchKey {
+
+void append(std::string_view text, std::string& out) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        const unsigned char c = static_cast<unsigned char>(text[pos]);
+
+        if (c < 0x80) {
+            out.push_back(c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : static_cast<char>(c));
+            ++pos;
+            continue;
+        }
+
+        uint32_t cp = 0;
+        const size_t length = decode(text.substr(pos), cp);
+        if (length == 0) {
+            out.push_back(static_cast<char>(c));
+            ++pos;
+            continue;
+        }
+
+        if (!isDiacritic(cp)) {
+            const auto* end = std::end(KEY_CODEPOINTS);
+            const auto* it = std::lower_bound(std::begin(KEY_CODEPOINTS), end, cp);
+            if (it != end && *it == cp) {
+                const size_t index = static_cast<size_t>(it - std::begin(KEY_CODEPOINTS));
+                out.append(KEY_DATA + KEY_OFFSETS[index], KEY_OFFSETS[index + 1] - KEY_OFFSETS[index]);
+            } else {
+                out.append(text.substr(pos, length));
+            }
+        }
+        pos += length;
+    }
+}
+
+std::string make(std::string_view text) {
+    std::string key;
+    key.reserve(text.size());
+    append(text, key);
+    return key;
+}
+
+void assign(std::string_view text, std::string& out) {
+    out.clear();
+    append(text, out);
+}
+
+} // namespace SearchKey
@@ -0,0 +1,31 @@
+#ifndef SEARCH_KEY_HPP
+#define SEARCH_KEY_HPP
+
+#include <string>
+#include <string_view>
+
+// Normalized search keys shared by the launcher, theme and grid-search.
+//
+// A key is the UTF-8 text after compatibility decomposition (NFKD),
+// with combining diacritics removed and full case folding applied. So
+// "Éditeur", "EDITEUR" and "éditeur" all share the key "editeur",
+// "ﬁ" matches "fi", and "İstanbul" matches "istanbul". Names get their key
+// once at load; each query gets one per keystroke, and matching is then a
+// plain byte-wise substring search of one key in another.
+//
+// Scripts without case or accents (CJK, Hangul, ...) pass through
+// unchanged. Invalid UTF-8 bytes are copied as they are.
+namespace SearchKey {
+
+// Append the key of `text` to `out`
+void append(std::string_view text, std::string& out);
+
+// The key of `text`
+std::string make(std::string_view text);
+
+// Replace `out` with the key of `text`, reusing its capacity
+void assign(std::string_view text, std::string& out);
+
+} // namespace SearchKey
+
+#endif // SEARCH_KEY_HPP
@@ -0,0 +1,181 @@
+#ifndef SEARCH_WORKER_HPP
+#define SEARCH_WORKER_HPP
+
+#include "CancelToken.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// Runs searches on a background thread so typing never waits for them.
+//
+// Every submit() gets the next generation number. The worker only ever runs
+// the newest query: one submitted while another is running cancels it
+// through its CancelToken, and queries typed in between are skipped. A
+// finished result is parked in a one-slot mailbox and the eventfd becomes
+// readable; the UI loop registers eventFd() with IBackend::addFd and calls
+// dispatch(), which hands over the result only if no newer query has been
+// submitted since.
+//
+// The data the search reads is shared with the UI thread. Searches run
+// holding the worker's data lock, and the UI takes it through pause()
+// before modifying that data: pause() cancels the running search, which is
+// started over once the lock is released.
+template <typename Result>
+class SearchWorker {
+  public:
+    // Runs on the worker thread. Poll `cancel` and return early when it
+    // fires; the result of a cancelled search is thrown away.
+    using SearchFn = std::function<void(const std::string& query, const CancelToken& cancel, Result& out)>;
+    // Runs on the UI thread, from dispatch()
+    using ResultFn = std::function<void(const std::string& query, Result& result)>;
+
+    SearchWorker(SearchFn search, ResultFn onResult)
+        : m_search(std::move(search)), m_onResult(std::move(onResult)),
+          m_eventFd(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)), m_thread([this] { run(); }) {
+    }
+
+    ~SearchWorker() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_epoch.fetch_add(1, std::memory_order_relaxed);
+        m_wake.notify_one();
+        m_thread.join();
+
+        if (m_eventFd >= 0) {
+            ::close(m_eventFd);
+        }
+    }
+
+    SearchWorker(const SearchWorker&) = delete;
+    SearchWorker& operator=(const SearchWorker&) = delete;
+
+    int eventFd() const { return m_eventFd; }
+
+    // Queue `query`, superseding anything queued or running. Returns its
+    // generation.
+    uint64_t submit(std::string query) {
+        uint64_t generation;
+        {
+            std::lock_guard lock(m_mutex);
+            // Bumped before the query is visible, so the worker cannot pick
+            // it up under the old epoch and cancel itself
+            m_epoch.fetch_add(1, std::memory_order_relaxed);
+            generation = ++m_submitted;
+            m_pending = std::move(query);
+        }
+        m_wake.notify_one();
+        return generation;
+    }
+
+    // Drop whatever is queued or running without asking for anything new
+    void cancel() {
+        std::lock_guard lock(m_mutex);
+        m_epoch.fetch_add(1, std::memory_order_relaxed);
+        ++m_submitted;
+        m_pending.reset();
+    }
+
+    // Hold the returned lock while changing anything the search reads
+    std::unique_lock<std::mutex> pause() {
+        m_epoch.fetch_add(1, std::memory_order_relaxed);
+        return std::unique_lock(m_dataMutex);
+    }
+
+    // Call when eventFd() is readable
+    void dispatch() {
+        uint64_t count = 0;
+        while (::read(m_eventFd, &count, sizeof(count)) > 0) {
+        }
+
+        std::string query;
+        Result result;
+        {
+            std::lock_guard lock(m_mutex);
+            if (!m_finished || m_finishedGeneration != m_submitted) {
+                m_finished.reset();
+                return;
+            }
+            query = std::move(m_finishedQuery);
+            result = std::move(*m_finished);
+            m_finished.reset();
+        }
+        m_onResult(query, result);
+    }
+
+  private:
+    void run() {
+        std::string query;
+        Result result;
+
+        for (;;) {
+            uint64_t generation;
+            {
+                std::unique_lock lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_stopping || m_pending; });
+                if (m_stopping) return;
+
+                query = std::move(*m_pending);
+                m_pending.reset();
+                generation = m_submitted;
+            }
+
+            bool interrupted;
+            {
+                std::lock_guard data(m_dataMutex);
+                const CancelToken cancel(m_epoch, m_epoch.load(std::memory_order_relaxed));
+                m_search(query, cancel, result);
+                interrupted = cancel.cancelled();
+            }
+
+            std::lock_guard lock(m_mutex);
+            if (m_stopping) return;
+            if (generation != m_submitted) continue;
+
+            if (interrupted) {
+                // Paused rather than superseded: run it again once the UI is done
+                if (!m_pending) m_pending = std::move(query);
+                continue;
+            }
+
+            m_finished = std::move(result);
+            m_finishedQuery = std::move(query);
+            m_finishedGeneration = generation;
+            result = Result{};
+
+            const uint64_t one = 1;
+            [[maybe_unused]] ssize_t written = ::write(m_eventFd, &one, sizeof(one));
+        }
+    }
+
+    SearchFn m_search;
+    ResultFn m_onResult;
+    int m_eventFd;
+
+    // Bumped to cancel the running search
+    std::atomic<uint64_t> m_epoch{0};
+    std::mutex m_dataMutex;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::optional<std::string> m_pending;
+    uint64_t m_submitted = 0;
+    std::optional<Result> m_finished;
+    std::string m_finishedQuery;
+    uint64_t m_finishedGeneration = 0;
+    bool m_stopping = false;
+
+    // Last, so it starts once everything above is initialized
+    std::thread m_thread;
+};
+
+#endif // SEARCH_WORKER_HPP
@@ -0,0 +1,176 @@
+#include "SubstringScan.hpp"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SUBSTRING_SCAN_X86 1
+#endif
+
+namespace {
+
+constexpr size_t NPOS = std::string_view::npos;
+
+// Offset of `needle` (at least 2 bytes) in `data`, which is at least as long
+using FindFn = size_t (*)(const char* data, size_t size, const char* needle, size_t length);
+
+size_t findScalar(const char* data, size_t size, const char* needle, size_t length) {
+    return std::string_view(data, size).find(std::string_view(needle, length));
+}
+
+#ifdef SUBSTRING_SCAN_X86
+
+// Every block compares positions [i, i + 16): their first bytes are loaded
+// from data + i and their last bytes from data + i + length - 1. The loop
+// stops while both loads still end inside `data`; the scalar search takes
+// the tail.
+__attribute__((target("sse2")))
+size_t findSse2(const char* data, size_t size, const char* needle, size_t length) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[length - 1]);
+    const size_t starts = size - length + 1;
+
+    size_t i = 0;
+    for (; i + 16 <= starts; i += 16) {
+        const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + length - 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last))));
+
+        while (mask != 0) {
+            const unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            if (std::memcmp(data + i + bit + 1, needle + 1, length - 2) == 0) return i + bit;
+            mask &= mask - 1;
+        }
+    }
+
+    const size_t rest = findScalar(data + i, size - i, needle, length);
+    return rest == NPOS ? NPOS : i + rest;
+}
+
+__attribute__((target("avx2")))
+size_t findAvx2(const char* data, size_t size, const char* needle, size_t length) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[length - 1]);
+    const size_t starts = size - length + 1;
+
+    size_t i = 0;
+
+    // Two blocks per step with one branch for both, since most steps find
+    // nothing at all
+    for (; i + 64 <= starts; i += 64) {
+        const __m256i eq0 = _mm256_and_si256(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), first),
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + length - 1)), last));
+        const __m256i eq1 = _mm256_and_si256(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32)), first),
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32 + length - 1)), last));
+        if (_mm256_testz_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq0, eq1))) continue;
+
+        uint64_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq0)) |
+                        (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(eq1))) << 32);
+        while (mask != 0) {
+            const unsigned bit = static_cast<unsigned>(__builtin_ctzll(mask));
+            if (std::memcmp(data + i + bit + 1, needle + 1, length - 2) == 0) return i + bit;
+            mask &= mask - 1;
+        }
+    }
+
+    for (; i + 32 <= starts; i += 32) {
+        const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + length - 1));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last))));
+
+        while (mask != 0) {
+            const unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            if (std::memcmp(data + i + bit + 1, needle + 1, length - 2) == 0) return i + bit;
+            mask &= mask - 1;
+        }
+    }
+
+    // Fewer than 32 starts left: finish 16 at a time
+    const size_t rest = findSse2(data + i, size - i, needle, length);
+    return rest == NPOS ? NPOS : i + rest;
+}
+
+#endif // SUBSTRING_SCAN_X86
+
+FindFn kernelFunction(SubstringScan::Kernel kernel) {
+    switch (kernel) {
+#ifdef SUBSTRING_SCAN_X86
+        case SubstringScan::Kernel::AVX2: return findAvx2;
+        case SubstringScan::Kernel::SSE2: return findSse2;
+#endif
+        default: return findScalar;
+    }
+}
+
+struct Dispatch {
+    SubstringScan::Kernel kernel;
+    FindFn find;
+};
+
+Dispatch& dispatch() {
+    static Dispatch active = {SubstringScan::bestKernel(), kernelFunction(SubstringScan::bestKernel())};
+    return active;
+}
+
+} // namespace
+
+namespace SubstringScan {
+
+Kernel bestKernel() {
+#ifdef SUBSTRING_SCAN_X86
+    static const Kernel best = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return Kernel::AVX2;
+        if (__builtin_cpu_supports("sse2")) return Kernel::SSE2;
+        return Kernel::SCALAR;
+    }();
+    return best;
+#else
+    return Kernel::SCALAR;
+#endif
+}
+
+Kernel activeKernel() {
+    return dispatch().kernel;
+}
+
+const char* kernelName(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::AVX2: return "avx2";
+        case Kernel::SSE2: return "sse2";
+        default: return "scalar";
+    }
+}
+
+void setKernel(Kernel kernel) {
+    // Kernels are ordered by the instruction sets they need
+    if (static_cast<int>(kernel) > static_cast<int>(bestKernel())) {
+        kernel = bestKernel();
+    }
+    dispatch() = {kernel, kernelFunction(kernel)};
+}
+
+size_t find(std::string_view haystack, std::string_view needle, size_t from) {
+    if (from > haystack.size()) return NPOS;
+
+    const size_t length = needle.size();
+    const size_t size = haystack.size() - from;
+    const char* data = haystack.data() + from;
+
+    if (length == 0) return from;
+    if (length > size) return NPOS;
+
+    if (length == 1) {
+        const void* hit = std::memchr(data, needle[0], size);
+        return hit ? static_cast<size_t>(static_cast<const char*>(hit) - haystack.data()) : NPOS;
+    }
+
+    const size_t pos = dispatch().find(data, size, needle.data(), length);
+    return pos == NPOS ? NPOS : from + pos;
+}
+
+} // namespace SubstringScan
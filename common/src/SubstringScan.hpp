@@ -0,0 +1,43 @@
+#ifndef SUBSTRING_SCAN_HPP
+#define SUBSTRING_SCAN_HPP
+
+#include <cstddef>
+#include <string_view>
+
+// Substring search tuned for many short keys packed into one buffer.
+//
+// The vector kernels broadcast the first and last byte of the needle and
+// compare them against 32 (AVX2) or 16 (SSE2) candidate positions per step;
+// only positions where both bytes match are verified with memcmp. That
+// discards almost every position with two compares, no matter how long the
+// needle is. The kernel is picked once at startup from what the CPU
+// supports; other architectures use the scalar one.
+namespace SubstringScan {
+
+enum class Kernel {
+    SCALAR,
+    SSE2,
+    AVX2,
+};
+
+// Fastest kernel this CPU supports
+Kernel bestKernel();
+
+Kernel activeKernel();
+const char* kernelName(Kernel kernel);
+
+// Override the kernel, for benchmarks and comparisons. Kernels the CPU does
+// not support fall back to bestKernel().
+void setKernel(Kernel kernel);
+
+// Position of the first occurrence of `needle` in `haystack` at or after
+// `from`, or npos. An empty needle matches at `from`.
+size_t find(std::string_view haystack, std::string_view needle, size_t from = 0);
+
+inline bool contains(std::string_view haystack, std::string_view needle) {
+    return find(haystack, needle) != std::string_view::npos;
+}
+
+} // namespace SubstringScan
+
+#endif // SUBSTRING_SCAN_HPP
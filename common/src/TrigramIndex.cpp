@@ -0,0 +1,158 @@
+#include "TrigramIndex.hpp"
+#include <algorithm>
+
+namespace {
+
+// Distinct trigrams of `key`, packed three bytes to an integer, ascending
+void collectTrigrams(std::string_view key, std::vector<uint32_t>& out) {
+    out.clear();
+    for (size_t i = 0; i + 3 <= key.size(); ++i) {
+        out.push_back(static_cast<uint32_t>(static_cast<unsigned char>(key[i])) << 16 |
+                      static_cast<uint32_t>(static_cast<unsigned char>(key[i + 1])) << 8 |
+                      static_cast<uint32_t>(static_cast<unsigned char>(key[i + 2])));
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void appendVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t readVarint(const uint8_t*& pos) {
+    uint32_t value = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        const uint8_t byte = *pos++;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (byte < 0x80) return value;
+    }
+}
+
+// Intersection stops once the next list is this many times longer than
+// the candidates left
+constexpr uint32_t MAX_SKEW = 32;
+
+// Scratch lists, reused so a warmed-up index does not allocate per call
+thread_local std::vector<uint32_t> t_trigrams;
+thread_local std::vector<uint32_t> t_ids;
+
+} // namespace
+
+void TrigramIndex::clear() {
+    m_postings.clear();
+    m_postingBytes = 0;
+}
+
+void TrigramIndex::encode(const std::vector<uint32_t>& ids, Posting& posting) {
+    posting.deltas.clear();
+    posting.last = 0;
+    for (uint32_t id : ids) {
+        appendVarint(posting.deltas, id - posting.last);
+        posting.last = id;
+    }
+    posting.count = static_cast<uint32_t>(ids.size());
+}
+
+void TrigramIndex::decode(const Posting& posting, std::vector<uint32_t>& ids) {
+    ids.clear();
+    const uint8_t* pos = posting.deltas.data();
+    uint32_t id = 0;
+    for (uint32_t i = 0; i < posting.count; ++i) {
+        id += readVarint(pos);
+        ids.push_back(id);
+    }
+}
+
+void TrigramIndex::add(uint32_t id, std::string_view key) {
+    collectTrigrams(key, t_trigrams);
+
+    for (uint32_t trigram : t_trigrams) {
+        Posting& posting = m_postings[trigram];
+        m_postingBytes -= posting.deltas.size();
+
+        if (posting.count == 0 || id > posting.last) {
+            // The usual case while loading: IDs arrive in ascending order
+            appendVarint(posting.deltas, id - posting.last);
+            posting.last = id;
+            ++posting.count;
+        } else {
+            decode(posting, t_ids);
+            t_ids.insert(std::lower_bound(t_ids.begin(), t_ids.end(), id), id);
+            encode(t_ids, posting);
+        }
+
+        m_postingBytes += posting.deltas.size();
+    }
+}
+
+void TrigramIndex::remove(uint32_t id, std::string_view key) {
+    collectTrigrams(key, t_trigrams);
+
+    for (uint32_t trigram : t_trigrams) {
+        auto it = m_postings.find(trigram);
+        if (it == m_postings.end()) continue;
+
+        Posting& posting = it->second;
+        m_postingBytes -= posting.deltas.size();
+
+        decode(posting, t_ids);
+        auto pos = std::lower_bound(t_ids.begin(), t_ids.end(), id);
+        if (pos != t_ids.end() && *pos == id) t_ids.erase(pos);
+
+        if (t_ids.empty()) {
+            m_postings.erase(it);
+        } else {
+            encode(t_ids, posting);
+            m_postingBytes += posting.deltas.size();
+        }
+    }
+}
+
+bool TrigramIndex::candidates(std::string_view needle, std::vector<uint32_t>& out) const {
+    if (needle.size() < 3) return false;
+
+    collectTrigrams(needle, t_trigrams);
+
+    thread_local std::vector<const Posting*> lists;
+    lists.clear();
+    for (uint32_t trigram : t_trigrams) {
+        auto it = m_postings.find(trigram);
+        if (it == m_postings.end()) {
+            out.clear();
+            return true;
+        }
+        lists.push_back(&it->second);
+    }
+
+    // Start from the shortest list so every later step can only shrink it
+    std::sort(lists.begin(), lists.end(),
+              [](const Posting* a, const Posting* b) { return a->count < b->count; });
+    decode(*lists.front(), out);
+
+    for (size_t i = 1; i < lists.size() && !out.empty(); ++i) {
+        // Decoding a list much longer than the survivors costs more than
+        // the caller verifying the survivors directly
+        const Posting& posting = *lists[i];
+        if (posting.count / MAX_SKEW > out.size()) break;
+
+        // Stream the longer list against the survivors, keeping matches in place
+        const uint8_t* pos = posting.deltas.data();
+        uint32_t remaining = posting.count;
+        uint32_t id = remaining > 0 ? readVarint(pos) : 0;
+
+        size_t kept = 0;
+        for (uint32_t candidate : out) {
+            while (remaining > 0 && id < candidate) {
+                if (--remaining > 0) id += readVarint(pos);
+            }
+            if (remaining == 0) break;
+            if (id == candidate) out[kept++] = candidate;
+        }
+        out.resize(kept);
+    }
+    return true;
+}
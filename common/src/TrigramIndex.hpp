@@ -0,0 +1,52 @@
+#ifndef TRIGRAM_INDEX_HPP
+#define TRIGRAM_INDEX_HPP
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Inverted index from every three-byte substring of a set of keys to the
+// IDs of the keys containing it.
+//
+// A needle of three or more bytes can only occur in keys that contain all
+// of its trigrams, so intersecting their posting lists yields a candidate
+// set that is usually a tiny fraction of the collection; the caller still
+// verifies each candidate, since the trigrams may sit apart. Posting lists
+// are ascending IDs stored as LEB128-encoded deltas, which keeps most
+// entries to one byte. Adding IDs in ascending order appends to the lists;
+// anything else rewrites the affected lists.
+class TrigramIndex {
+  public:
+    void clear();
+
+    // Index `key` under `id`, which must not be indexed yet
+    void add(uint32_t id, std::string_view key);
+    // Drop `id`, which must have been indexed with this `key`
+    void remove(uint32_t id, std::string_view key);
+
+    // Fill `out` with ascending IDs that include every key holding all the
+    // trigrams of `needle`; intersection stops early once few candidates
+    // are left, so some may lack a trigram. Returns false, leaving `out`
+    // alone, if the needle is too short to have trigrams.
+    bool candidates(std::string_view needle, std::vector<uint32_t>& out) const;
+
+    size_t trigramCount() const { return m_postings.size(); }
+    // Encoded posting bytes, excluding the hash table itself
+    size_t postingBytes() const { return m_postingBytes; }
+
+  private:
+    struct Posting {
+        std::vector<uint8_t> deltas;
+        uint32_t last = 0;
+        uint32_t count = 0;
+    };
+
+    static void encode(const std::vector<uint32_t>& ids, Posting& posting);
+    static void decode(const Posting& posting, std::vector<uint32_t>& ids);
+
+    std::unordered_map<uint32_t, Posting> m_postings;
+    size_t m_postingBytes = 0;
+};
+
+#endif // TRIGRAM_INDEX_HPP
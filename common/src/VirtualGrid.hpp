@@ -0,0 +1,240 @@
+#ifndef VIRTUAL_GRID_HPP
+#define VIRTUAL_GRID_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// How cells are laid out: `columns` per row, rows `rowPitch` apart
+struct GridGeometry {
+    size_t columns = 1;
+    float rowPitch = 1;
+};
+
+// Cells of a scrolled grid (or list, with one column) of `count` items,
+// kept only for the rows intersecting the viewport plus OVERSCAN_ROWS on
+// each side. A cell scrolled out of that window goes to a pool, and the
+// next item scrolled in rebinds it instead of building a new one, so the
+// number of cells follows the viewport size and not the item count.
+//
+// The rows follow from the scroll offset and the fixed row pitch alone, so
+// nothing has to be built or measured to find them. Building and placing
+// cells is left to a Host, which sizes its container for all `count` items
+// so the scrollbar covers the rows without cells. A Host provides:
+//
+//   using CellPtr = ...;                          // shared handle to a cell
+//   CellPtr makeCell(size_t index);               // null on failure
+//   void bindCell(const CellPtr& cell, size_t index);  // show another item
+//   void placeCell(const CellPtr& cell, size_t index); // into the container
+//   void removeCell(const CellPtr& cell);              // out of it
+//
+// Hosts that keep their container across updates can reconcile() instead
+// of reset(), and only the cells of items that entered the window change.
+template <typename Host>
+class VirtualGrid {
+  public:
+    using CellPtr = typename Host::CellPtr;
+
+    // Rows kept beyond each edge of the viewport, so short scrolls find
+    // their cells already placed
+    static constexpr size_t OVERSCAN_ROWS = 4;
+
+    struct Stats {
+        uint64_t built = 0;
+        uint64_t rebound = 0;
+        // Taken out of the container into the pool
+        uint64_t released = 0;
+        // Kept by reconcile(), at another index or at the same one
+        uint64_t moved = 0;
+        uint64_t kept = 0;
+        uint64_t destroyed = 0;
+    };
+
+    explicit VirtualGrid(Host& host) : m_host(host) {}
+
+    // Lay out `count` items anew, scrolled to `offset` of a viewport
+    // `height` tall. Cells in use are pooled; the host has already taken
+    // them out of its container.
+    void reset(size_t count, GridGeometry geometry, float offset, float height) {
+        m_pool.insert(m_pool.end(), std::make_move_iterator(m_cells.begin()),
+                      std::make_move_iterator(m_cells.end()));
+        m_cells.clear();
+        m_first = 0;
+
+        setLayout(count, geometry);
+        setViewport(offset, height);
+    }
+
+    // Lay out `count` items anew like reset(), except that cells stay in
+    // the container: a cell whose item is in the new window keeps showing
+    // it, moved if its index changed, and only cells of items that left are
+    // rebound to the items that entered. Cells are matched by key, which is
+    // unique among items; the Host also provides:
+    //
+    //   Key cellKey(const CellPtr& cell);                  // of its item
+    //   Key itemKey(size_t index);                         // of a new item
+    //   void moveCell(const CellPtr& cell, size_t index);  // same item
+    void reconcile(size_t count, GridGeometry geometry, float offset, float height) {
+        using Key = decltype(m_host.itemKey(size_t{0}));
+
+        setLayout(count, geometry);
+        m_offset = std::max(offset, 0.F);
+        m_height = std::max(height, 0.F);
+        const auto [first, last] = window();
+
+        // The window is a screenful of items, so a sorted vector beats a
+        // hash map here
+        std::vector<std::pair<Key, size_t>> wanted;
+        wanted.reserve(last - first);
+        for (size_t index = first; index < last; ++index) wanted.emplace_back(m_host.itemKey(index), index);
+        std::sort(wanted.begin(), wanted.end());
+
+        std::vector<CellPtr> cells(last - first);
+        for (size_t slot = 0; slot < m_cells.size(); ++slot) {
+            CellPtr& cell = m_cells[slot];
+            if (!cell) continue;
+
+            const Key key = m_host.cellKey(cell);
+            auto it = std::lower_bound(wanted.begin(), wanted.end(), key,
+                                       [](const auto& entry, const Key& value) { return entry.first < value; });
+            if (it == wanted.end() || it->first != key) {
+                release(cell);
+                continue;
+            }
+
+            const size_t index = it->second;
+            if (index == m_first + slot) {
+                ++m_stats.kept;
+            } else {
+                m_host.moveCell(cell, index);
+                ++m_stats.moved;
+            }
+            cells[index - first] = std::move(cell);
+        }
+
+        fill(cells, first, last);
+        m_cells = std::move(cells);
+        m_first = first;
+    }
+
+    // Follow the viewport. Cheap when the window of rows does not change.
+    void setViewport(float offset, float height) {
+        m_offset = std::max(offset, 0.F);
+        m_height = std::max(height, 0.F);
+        updateWindow();
+    }
+
+    // Drop every cell; the host clears whatever holds them
+    void clear() {
+        m_stats.destroyed += m_cells.size() + m_pool.size();
+        m_cells.clear();
+        m_pool.clear();
+        m_count = 0;
+        m_first = 0;
+    }
+
+    size_t count() const { return m_count; }
+    const GridGeometry& geometry() const { return m_geometry; }
+
+    // The cell showing item `index`, null while it is outside the window
+    CellPtr cell(size_t index) const {
+        if (index < m_first || index - m_first >= m_cells.size()) return nullptr;
+        return m_cells[index - m_first];
+    }
+    // Items [first(), first() + materialized()) have cells, bar failures
+    size_t first() const { return m_first; }
+    size_t materialized() const { return m_cells.size(); }
+    size_t pooled() const { return m_pool.size(); }
+
+    const Stats& stats() const { return m_stats; }
+
+  private:
+    void setLayout(size_t count, GridGeometry geometry) {
+        m_count = count;
+        m_geometry = geometry;
+        m_geometry.columns = std::max<size_t>(m_geometry.columns, 1);
+        m_geometry.rowPitch = std::max(m_geometry.rowPitch, 1.F);
+    }
+
+    // Items [first, last) in the rows of the viewport, plus overscan
+    std::pair<size_t, size_t> window() const {
+        const size_t rows = (m_count + m_geometry.columns - 1) / m_geometry.columns;
+        const auto firstVisible = static_cast<size_t>(m_offset / m_geometry.rowPitch);
+        const auto lastVisible = static_cast<size_t>(std::ceil((m_offset + m_height) / m_geometry.rowPitch));
+
+        const size_t firstRow = firstVisible > OVERSCAN_ROWS ? firstVisible - OVERSCAN_ROWS : 0;
+        const size_t lastRow = std::min(rows, std::max(lastVisible, firstVisible + 1) + OVERSCAN_ROWS);
+        const size_t first = std::min(firstRow * m_geometry.columns, m_count);
+        return {first, std::max(first, std::min(lastRow * m_geometry.columns, m_count))};
+    }
+
+    void updateWindow() {
+        const auto [first, last] = window();
+        if (first == m_first && last - first == m_cells.size()) return;
+
+        // Cells leaving the window go to the pool first, so entering items
+        // can take them
+        const size_t oldFirst = m_first;
+        const size_t oldLast = m_first + m_cells.size();
+        for (size_t index = oldFirst; index < oldLast; ++index) {
+            if (index >= first && index < last) continue;
+            CellPtr& slot = m_cells[index - oldFirst];
+            if (slot) release(slot);
+        }
+
+        std::vector<CellPtr> cells(last - first);
+        for (size_t index = std::max(first, oldFirst); index < std::min(last, oldLast); ++index) {
+            cells[index - first] = std::move(m_cells[index - oldFirst]);
+        }
+        fill(cells, first, last);
+        m_cells = std::move(cells);
+        m_first = first;
+    }
+
+    void release(CellPtr& cell) {
+        m_host.removeCell(cell);
+        m_pool.push_back(std::move(cell));
+        ++m_stats.released;
+    }
+
+    // Give the empty slots of `cells`, items [first, last), a cell each
+    void fill(std::vector<CellPtr>& cells, size_t first, size_t last) {
+        for (size_t index = first; index < last; ++index) {
+            CellPtr& slot = cells[index - first];
+            if (slot) continue;
+            slot = acquire(index);
+            if (slot) m_host.placeCell(slot, index);
+        }
+    }
+
+    CellPtr acquire(size_t index) {
+        if (m_pool.empty()) {
+            CellPtr cell = m_host.makeCell(index);
+            if (cell) ++m_stats.built;
+            return cell;
+        }
+        CellPtr cell = std::move(m_pool.back());
+        m_pool.pop_back();
+        m_host.bindCell(cell, index);
+        ++m_stats.rebound;
+        return cell;
+    }
+
+    Host& m_host;
+    size_t m_count = 0;
+    GridGeometry m_geometry;
+    float m_offset = 0;
+    float m_height = 0;
+
+    // Cells of items [m_first, m_first + m_cells.size()), null where
+    // building one failed
+    size_t m_first = 0;
+    std::vector<CellPtr> m_cells;
+    std::vector<CellPtr> m_pool;
+    Stats m_stats;
+};
+
+#endif // VIRTUAL_GRID_HPP
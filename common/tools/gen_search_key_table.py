@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""Generate common/src/SearchKeyTable.inc from Python's Unicode database.
+
+For every code point in the scripts people type into a search box (Latin,
+Greek, Cyrillic, Armenian, general punctuation and compatibility forms) the
+table records the search key when it differs from the character itself:
+NFKD decomposition, combining diacritics removed, full case folding, and the
+decomposition repeated so folded characters lose their accents too.
+
+Usage: gen_search_key_table.py > common/src/SearchKeyTable.inc
+"""
+
+import unicodedata
+
+RANGES = [
+    (0x0080, 0x02FF),  # Latin-1 Supplement, Latin Extended-A/B, IPA, modifiers
+    (0x0370, 0x03FF),  # Greek
+    (0x0400, 0x052F),  # Cyrillic and Cyrillic Supplement
+    (0x0531, 0x058F),  # Armenian
+    (0x1E00, 0x1FFF),  # Latin Extended Additional, Greek Extended
+    (0x2000, 0x218F),  # Punctuation, super/subscripts, letterlike, numerals
+    (0x2460, 0x24FF),  # Enclosed alphanumerics
+    (0x2C60, 0x2C7F),  # Latin Extended-C
+    (0xA720, 0xA7FF),  # Latin Extended-D
+    (0xFB00, 0xFB4F),  # Alphabetic presentation forms (ligatures)
+    (0xFF00, 0xFFEF),  # Halfwidth and fullwidth forms
+]
+
+# Must match isDiacritic() in SearchKey.cpp
+DIACRITIC_BLOCKS = [
+    (0x0300, 0x036F),
+    (0x1AB0, 0x1AFF),
+    (0x1DC0, 0x1DFF),
+    (0x20D0, 0x20FF),
+    (0xFE20, 0xFE2F),
+]
+
+# Folds people expect that Unicode does not provide: Turkish dotless i
+OVERRIDES = {
+    0x0131: "i",
+}
+
+
+def is_diacritic(cp):
+    return any(lo <= cp <= hi for lo, hi in DIACRITIC_BLOCKS)
+
+
+def strip(text):
+    return "".join(c for c in text if not is_diacritic(ord(c)))
+
+
+def search_key(ch):
+    key = strip(unicodedata.normalize("NFKD", ch)).casefold()
+    return strip(unicodedata.normalize("NFKD", key))
+
+
+def c_string(data):
+    out = []
+    for byte in data:
+        # '?' too, so sequences like "??!" are not read as trigraphs
+        if byte in (ord('"'), ord("\\"), ord("?")):
+            out.append("\\" + chr(byte))
+        elif 0x20 <= byte < 0x7F:
+            out.append(chr(byte))
+        else:
+            out.append("\\%03o" % byte)
+    return "".join(out)
+
+
+def main():
+    entries = []
+    for lo, hi in RANGES:
+        for cp in range(lo, hi + 1):
+            ch = chr(cp)
+            if unicodedata.category(ch) in ("Cn", "Cs") or is_diacritic(cp):
+                continue
+            key = OVERRIDES.get(cp, search_key(ch))
+            if key != ch:
+                entries.append((cp, key.encode("utf-8")))
+
+    print("// Generated by common/tools/gen_search_key_table.py from Unicode %s; do not edit."
+          % unicodedata.unidata_version)
+    print()
+    print("// Code points whose search key differs from the character, ascending")
+    print("constexpr uint32_t KEY_CODEPOINTS[] = {")
+    for i in range(0, len(entries), 8):
+        print("    " + " ".join("0x%04X," % cp for cp, _ in entries[i:i + 8]))
+    print("};")
+    print()
+
+    print("// KEY_DATA offsets; entry i spans [KEY_OFFSETS[i], KEY_OFFSETS[i + 1])")
+    print("constexpr uint16_t KEY_OFFSETS[] = {")
+    offsets = [0]
+    for _, key in entries:
+        offsets.append(offsets[-1] + len(key))
+    for i in range(0, len(offsets), 12):
+        print("    " + " ".join("%d," % offset for offset in offsets[i:i + 12]))
+    print("};")
+    print()
+
+    print("constexpr char KEY_DATA[] =")
+    for i in range(0, len(entries), 16):
+        print('    "%s"' % c_string(b"".join(key for _, key in entries[i:i + 16])))
+    print("    ;")
+
+
+if __name__ == "__main__":
+    main()
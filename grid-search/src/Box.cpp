@@ -229,6 +229,24 @@ void Box::updateImage() {
     }
 }
 
+void Box::bind(const std::string& newTitle, const std::string& newImagePath,
+               Hyprtoolkit::CHyprColor newBorderColor) {
+    // Read by the border color callback on the next frame
+    m_borderColor = newBorderColor;
+    
+    if (newTitle != m_title) {
+        m_title = newTitle;
+        if (auto builder = m_text->rebuild()) {
+            builder->text(std::string{m_title})->commence();
+        }
+    }
+    
+    if (newImagePath != m_imagePath) {
+        m_imagePath = newImagePath;
+        updateImage();
+    }
+}
+
 // Setter implementations
 void Box::setTitle(const std::string& newTitle) {
     m_title = newTitle;
@@ -40,6 +40,11 @@ class Box {
     void setBorderRadius(int newRadius);
     void setBorderThickness(int newThickness);
     
+    // Show another item, rebuilding only the image and the title; used
+    // when GridLayout recycles the box
+    void bind(const std::string& newTitle, const std::string& newImagePath,
+              Hyprtoolkit::CHyprColor newBorderColor);
+    
   private:
     // Properties
     std::string m_title;
@@ -1,4 +1,5 @@
 #include "GridLayout.hpp"
+#include <algorithm>
 #include <iostream>
 
 GridLayout::GridLayout(Hyprutils::Memory::CSharedPointer<Hyprtoolkit::IBackend> backend,
@@ -55,6 +56,7 @@ void GridLayout::createUI() {
         
         m_scrollArea->addChild(m_gridContainer);
     } else {
+        m_scrollArea.reset();
         // Non-scrollable container
         m_gridContainer = Hyprtoolkit::CColumnLayoutBuilder::begin()
             ->gap(0)
@@ -64,26 +66,56 @@ void GridLayout::createUI() {
                 {1.0F, 1.0F}))
             ->commence();
     }
+    
+    // Sized by createGridStructure()
+    m_cellContainer = Hyprtoolkit::CRectangleBuilder::begin()
+        ->color([] { return Hyprtoolkit::CHyprColor(0, 0, 0, 0); })
+        ->size(Hyprtoolkit::CDynamicSize(
+            Hyprtoolkit::CDynamicSize::HT_SIZE_ABSOLUTE,
+            Hyprtoolkit::CDynamicSize::HT_SIZE_ABSOLUTE,
+            {0.0F, 0.0F}))
+        ->commence();
+    
+    // Scrolling and resizing reposition the container
+    m_cellContainer->setRepositioned([this]() {
+        queueViewportSync();
+    });
+    
+    m_gridContainer->addChild(m_cellContainer);
 }
 
-void GridLayout::addBox(std::unique_ptr<Box> box) {
-    if (!box) return;
-    
-    m_boxes.push_back(std::move(box));
+void GridLayout::setItems(std::vector<Item> items) {
+    m_items = std::move(items);
+    m_visibleBoxes.clear();
+    m_filtered = false;
     update();
 }
 
-void GridLayout::addBoxes(std::vector<std::unique_ptr<Box>> boxes) {
-    for (auto& box : boxes) {
-        if (box) {
-            m_boxes.push_back(std::move(box));
-        }
-    }
+void GridLayout::clear() {
+    m_items.clear();
+    m_visibleBoxes.clear();
+    m_filtered = false;
     update();
+    
+    // The boxes read the backend's palette, so they go now rather than
+    // with the grid
+    m_cellContainer->clearChildren();
+    m_cells.clear();
 }
 
-void GridLayout::clear() {
-    m_boxes.clear();
+void GridLayout::setVisibleBoxes(const std::vector<size_t>& indices) {
+    if (m_filtered && indices == m_visibleBoxes) return;
+    
+    m_visibleBoxes = indices;
+    m_filtered = true;
+    update();
+}
+
+void GridLayout::showAllBoxes() {
+    if (!m_filtered) return;
+    
+    m_visibleBoxes.clear();
+    m_filtered = false;
     update();
 }
 
@@ -122,11 +154,15 @@ void GridLayout::setConfig(const Config& newConfig) {
         createUI();
     }
     
+    // Boxes are built at the configured size, so none can be reused
+    m_cellContainer->clearChildren();
+    m_cells.clear();
+    
     update();
 }
 
 void GridLayout::calculateLayout() {
-    if (m_boxes.empty() || !m_window) {
+    if (visibleBoxCount() == 0 || !m_window) {
         m_columnCount = 0;
         m_rowCount = 0;
         m_gridWidth = 0.0f;
@@ -144,7 +180,7 @@ void GridLayout::calculateLayout() {
     int maxColumns = static_cast<int>(windowWidth / totalWidthPerColumn);
     
     // Ensure reasonable bounds
-    int totalBoxes = static_cast<int>(m_boxes.size());
+    int totalBoxes = static_cast<int>(visibleBoxCount());
     m_columnCount = std::max(1, std::min(maxColumns, totalBoxes));
     
     // Calculate rows needed (ceiling division)
@@ -166,91 +202,89 @@ void GridLayout::calculateLayout() {
 }
 
 void GridLayout::createGridStructure() {
-    // Clear existing content
-    m_gridContainer->clearChildren();
+    // Boxes in use go back to the pool; the ones in view are placed again
+    m_cellContainer->clearChildren();
     
-    if (m_boxes.empty()) {
-        std::cout << "[GridLayout] No boxes to create grid" << std::endl;
-        return;
+    if (auto builder = m_cellContainer->rebuild()) {
+        builder->size(Hyprtoolkit::CDynamicSize(
+                          Hyprtoolkit::CDynamicSize::HT_SIZE_ABSOLUTE,
+                          Hyprtoolkit::CDynamicSize::HT_SIZE_ABSOLUTE,
+                          {m_gridWidth, std::max(m_gridHeight, 0.0f)}))
+            ->commence();
     }
     
-    // Create wrapper for centering (if enabled)
-    Hyprutils::Memory::CSharedPointer<Hyprtoolkit::CColumnLayoutElement> gridWrapper;
-    
     if (m_config.centerHorizontal) {
-        gridWrapper = Hyprtoolkit::CColumnLayoutBuilder::begin()
-            ->gap(0)
-            ->size(Hyprtoolkit::CDynamicSize(
-                Hyprtoolkit::CDynamicSize::HT_SIZE_PERCENT,
-                Hyprtoolkit::CDynamicSize::HT_SIZE_AUTO,
-                {1.0F, 1.0F}))
-            ->commence();
-        
-        gridWrapper->setPositionMode(Hyprtoolkit::IElement::HT_POSITION_AUTO);
-        gridWrapper->setPositionFlag(Hyprtoolkit::IElement::HT_POSITION_FLAG_HCENTER, true);
-        
-        std::cout << "[GridLayout] Grid will be centered horizontally" << std::endl;
+        m_cellContainer->setPositionMode(Hyprtoolkit::IElement::HT_POSITION_AUTO);
+        m_cellContainer->setPositionFlag(Hyprtoolkit::IElement::HT_POSITION_FLAG_HCENTER, true);
     } else {
-        gridWrapper = m_gridContainer;
-        std::cout << "[GridLayout] Grid will be left-aligned" << std::endl;
+        m_cellContainer->setPositionFlag(Hyprtoolkit::IElement::HT_POSITION_FLAG_HCENTER, false);
     }
     
-    // Update vertical spacing
-    if (auto builder = gridWrapper->rebuild()) {
-        builder->gap(m_config.verticalSpacing)->commence();
-    }
-    
-    // Create rows
-    int totalBoxes = static_cast<int>(m_boxes.size());
-    
-    std::cout << "[GridLayout] Creating " << m_rowCount << " rows..." << std::endl;
+    const auto view = viewport();
+    m_cells.reset(visibleBoxCount(),
+                  {static_cast<size_t>(std::max(m_columnCount, 1)), m_config.boxSize + m_config.verticalSpacing},
+                  static_cast<float>(view.x), static_cast<float>(view.y));
     
-    for (int row = 0; row < m_rowCount; ++row) {
-        // Create row layout with exact width
-        auto rowLayout = Hyprtoolkit::CRowLayoutBuilder::begin()
-            ->gap(m_config.horizontalSpacing)
-            ->size(Hyprtoolkit::CDynamicSize(
-                Hyprtoolkit::CDynamicSize::HT_SIZE_AUTO,
-                Hyprtoolkit::CDynamicSize::HT_SIZE_AUTO,
-                {m_gridWidth, m_config.boxSize}))
-            ->commence();
-        
-        // Add boxes to row
-        for (int col = 0; col < m_columnCount; ++col) {
-            int index = (row * m_columnCount) + col;
-            
-            if (index < totalBoxes && m_boxes[index] && m_boxes[index]->getElement()) {
-                rowLayout->addChild(m_boxes[index]->getElement());
-            } else if (index >= totalBoxes) {
-                // Empty placeholder for alignment
-                auto emptySpace = Hyprtoolkit::CRectangleBuilder::begin()
-                    ->color([] { return Hyprtoolkit::CHyprColor(0, 0, 0, 0); })
-                    ->size(Hyprtoolkit::CDynamicSize(
-                        Hyprtoolkit::CDynamicSize::HT_SIZE_ABSOLUTE,
-                        Hyprtoolkit::CDynamicSize::HT_SIZE_ABSOLUTE,
-                        {m_config.boxSize, m_config.boxSize}))
-                    ->commence();
-                rowLayout->addChild(emptySpace);
-            }
-        }
-        
-        // Add row to wrapper
-        gridWrapper->addChild(rowLayout);
-        
-        // Force reposition of row immediately
-        rowLayout->forceReposition();
-    }
-    
-    // Add wrapper to container if centering is enabled
-    if (m_config.centerHorizontal && gridWrapper != m_gridContainer) {
-        m_gridContainer->addChild(gridWrapper);
-    }
+    std::cout << "[GridLayout] " << m_cells.materialized() << " of " << visibleBoxCount()
+              << " boxes placed (" << m_cells.stats().built << " built in total)" << std::endl;
+}
+
+Hyprutils::Math::Vector2D GridLayout::viewport() const {
+    // The window height stands in until the scroll area has been laid out
+    const double windowHeight = m_window ? m_window->pixelSize().y : 0.0;
+    if (!m_scrollArea) return {0.0, windowHeight};
     
-    // Force reposition of entire container
-    m_gridContainer->forceReposition();
-    if (m_scrollArea) {
-        m_scrollArea->forceReposition();
-    }
+    const double height = m_scrollArea->size().y;
+    return {m_scrollArea->getCurrentScroll().y, height > 0 ? height : windowHeight};
+}
+
+void GridLayout::syncViewport() {
+    const auto view = viewport();
+    m_cells.setViewport(static_cast<float>(view.x), static_cast<float>(view.y));
+}
+
+void GridLayout::queueViewportSync() {
+    // Children are not moved while the toolkit is positioning them
+    if (m_viewportSyncQueued || !m_backend) return;
+    m_viewportSyncQueued = true;
+    m_backend->addIdle([this]() {
+        m_viewportSyncQueued = false;
+        syncViewport();
+    });
+}
+
+GridLayout::CellHost::CellPtr GridLayout::CellHost::makeCell(size_t index) {
+    const Item& item = grid.visibleItem(index);
+    auto box = std::make_shared<Box>(
+        grid.m_backend,
+        item.title,
+        item.imagePath,
+        Hyprtoolkit::CHyprColor(0.15f, 0.15f, 0.15f, 1.0f),
+        item.borderColor,
+        Hyprtoolkit::CHyprColor(1.0f, 1.0f, 1.0f, 1.0f),
+        grid.m_config.boxSize, grid.m_config.boxSize,
+        10, 1
+    );
+    return box->getElement() ? box : nullptr;
+}
+
+void GridLayout::CellHost::bindCell(const CellPtr& box, size_t index) {
+    const Item& item = grid.visibleItem(index);
+    box->bind(item.title, item.imagePath, item.borderColor);
+}
+
+void GridLayout::CellHost::placeCell(const CellPtr& box, size_t index) {
+    const size_t columns = grid.m_cells.geometry().columns;
+    const float column = static_cast<float>(index % columns);
+    const float row = static_cast<float>(index / columns);
     
-    std::cout << "[GridLayout] Grid structure created successfully" << std::endl;
-}
\ No newline at end of file
+    auto element = box->getElement();
+    element->setPositionMode(Hyprtoolkit::IElement::HT_POSITION_ABSOLUTE);
+    element->setAbsolutePosition({column * (grid.m_config.boxSize + grid.m_config.horizontalSpacing),
+                                  row * grid.m_cells.geometry().rowPitch});
+    grid.m_cellContainer->addChild(element);
+}
+
+void GridLayout::CellHost::removeCell(const CellPtr& box) {
+    grid.m_cellContainer->removeChild(box->getElement());
+}
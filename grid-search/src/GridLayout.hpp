@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Box.hpp"
+#include "VirtualGrid.hpp"
 #include <hyprtoolkit/element/ColumnLayout.hpp>
 #include <hyprtoolkit/element/RowLayout.hpp>
 #include <hyprtoolkit/element/ScrollArea.hpp>
@@ -8,7 +9,11 @@
 #include <hyprtoolkit/window/Window.hpp>
 #include <vector>
 #include <memory>
+#include <string>
 
+// Boxes are built only for the rows in view (see VirtualGrid) and rebound
+// to other items as the grid scrolls, so a library of any size costs a
+// screenful of boxes.
 class GridLayout {
   public:
     // Configuration structure for grid properties
@@ -27,15 +32,25 @@ class GridLayout {
     // Destructor
     ~GridLayout();
     
-    // Add a box to the grid
-    void addBox(std::unique_ptr<Box> box);
+    // What a box shows
+    struct Item {
+        std::string title;
+        std::string imagePath;
+        Hyprtoolkit::CHyprColor borderColor = {0.2f, 0.5f, 0.8f, 1.0f};
+    };
     
-    // Add multiple boxes
-    void addBoxes(std::vector<std::unique_ptr<Box>> boxes);
+    // Replace the items shown
+    void setItems(std::vector<Item> items);
     
-    // Remove all boxes
+    // Remove all items
     void clear();
     
+    // Lay out only the boxes at `indices` (ascending), e.g. search matches
+    void setVisibleBoxes(const std::vector<size_t>& indices);
+    
+    // Lay out every box again
+    void showAllBoxes();
+    
     // Get the UI element to add to window/layout
     Hyprutils::Memory::CSharedPointer<Hyprtoolkit::IElement> getElement();
     
@@ -49,11 +64,25 @@ class GridLayout {
     // Getters for grid information
     int getColumnCount() const { return m_columnCount; }
     int getRowCount() const { return m_rowCount; }
-    int getTotalBoxes() const { return static_cast<int>(m_boxes.size()); }
+    int getTotalBoxes() const { return static_cast<int>(m_items.size()); }
+    // Boxes built for the rows in view, and kept for reuse
+    size_t getBuiltBoxes() const { return m_cells.materialized() + m_cells.pooled(); }
     float getGridWidth() const { return m_gridWidth; }
     float getGridHeight() const { return m_gridHeight; }
     
   private:
+    // Builds, rebinds and places the boxes of m_cells
+    struct CellHost {
+        using CellPtr = std::shared_ptr<Box>;
+        
+        GridLayout& grid;
+        
+        CellPtr makeCell(size_t index);
+        void bindCell(const CellPtr& box, size_t index);
+        void placeCell(const CellPtr& box, size_t index);
+        void removeCell(const CellPtr& box);
+    };
+    
     // Dependencies
     Hyprutils::Memory::CSharedPointer<Hyprtoolkit::IBackend> m_backend;
     Hyprutils::Memory::CSharedPointer<Hyprtoolkit::IWindow> m_window;
@@ -61,12 +90,22 @@ class GridLayout {
     // Configuration
     Config m_config;
     
-    // Box storage
-    std::vector<std::unique_ptr<Box>> m_boxes;
+    // Item storage
+    std::vector<Item> m_items;
+    
+    // Indices of the items laid out while a filter is active
+    std::vector<size_t> m_visibleBoxes;
+    bool m_filtered = false;
     
     // UI Elements
     Hyprutils::Memory::CSharedPointer<Hyprtoolkit::CScrollAreaElement> m_scrollArea;
     Hyprutils::Memory::CSharedPointer<Hyprtoolkit::CColumnLayoutElement> m_gridContainer;
+    // As large as the whole grid; boxes sit in it at absolute positions
+    Hyprutils::Memory::CSharedPointer<Hyprtoolkit::CRectangleElement> m_cellContainer;
+    
+    CellHost m_cellHost{*this};
+    VirtualGrid<CellHost> m_cells{m_cellHost};
+    bool m_viewportSyncQueued = false;
     
     // Signal listener for window resize
     Hyprutils::Signal::CHyprSignalListener m_resizeListener;
@@ -78,8 +117,17 @@ class GridLayout {
     float m_gridHeight = 0.0f;
     
     // Private methods
+    size_t visibleBoxCount() const { return m_filtered ? m_visibleBoxes.size() : m_items.size(); }
+    const Item& visibleItem(size_t index) const {
+        return m_items[m_filtered ? m_visibleBoxes[index] : index];
+    }
+    
     void createUI();
     void calculateLayout();
     void createGridStructure();
     void setupResizeHandler();
+    // Move the boxes to the rows in view
+    void syncViewport();
+    void queueViewportSync();
+    Hyprutils::Math::Vector2D viewport() const;
 };
\ No newline at end of file
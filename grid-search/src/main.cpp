@@ -8,6 +8,9 @@
 #include "SearchBox.hpp"
 #include "Box.hpp"
 #include "GridLayout.hpp"
+#include "IndexedKeys.hpp"
+#include "SearchKey.hpp"
+#include "SearchWorker.hpp"
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -148,8 +151,10 @@ int main() {
         config.centerHorizontal = true;
         grid->setConfig(config);
         
-        // 8. Create boxes for images
-        std::vector<std::unique_ptr<Box>> boxes;
+        // 8. Describe a box per image; GridLayout builds the ones in view
+        std::vector<GridLayout::Item> items;
+        items.reserve(imageFiles.size());
+        IndexedKeys searchKeys; // SearchKey of each item's file name
         std::vector<Hyprtoolkit::CHyprColor> borderColors = {
             {0.2f, 0.5f, 0.8f, 1.0f},   // Blue
             {0.8f, 0.3f, 0.3f, 1.0f},   // Red
@@ -161,6 +166,7 @@ int main() {
         for (size_t i = 0; i < imageFiles.size(); ++i) {
             const auto& path = imageFiles[i];
             std::string filename = getFileNameWithoutExtension(path);
+            searchKeys.append(SearchKey::make(filename));
             
             // Truncate long names
             std::string displayName = filename;
@@ -168,21 +174,11 @@ int main() {
                 displayName = displayName.substr(0, 12) + "...";
             }
             
-            auto box = std::make_unique<Box>(
-                backend,
-                displayName,
-                path.string(),
-                Hyprtoolkit::CHyprColor(0.15f, 0.15f, 0.15f, 1.0f),
-                borderColors[i % borderColors.size()],
-                Hyprtoolkit::CHyprColor(1.0f, 1.0f, 1.0f, 1.0f),
-                config.boxSize, config.boxSize,
-                10, 1
-            );
-            boxes.push_back(std::move(box));
+            items.push_back({std::move(displayName), path.string(), borderColors[i % borderColors.size()]});
         }
         
-        // 9. Add boxes to grid
-        grid->addBoxes(std::move(boxes));
+        // 9. Hand the items to the grid
+        grid->setItems(std::move(items));
         
         // 10. Content container (90% height)
         auto contentContainer = Hyprtoolkit::CRectangleBuilder::begin()
@@ -200,9 +196,30 @@ int main() {
         mainLayout->addChild(contentContainer);
         root->addChild(mainLayout);
         
-        // 12. Setup search box callbacks
-        searchBox->setOnTextChanged([](const std::string& text) {
+        // 12. Search on a worker thread; results come back through an eventfd
+        SearchWorker<std::vector<size_t>> searchWorker(
+            [&searchKeys](const std::string& text, const CancelToken& cancel, std::vector<size_t>& matches) {
+                matches.clear();
+                if (text.empty()) return;
+                
+                // Names were normalized at load; only the query is per keystroke
+                searchKeys.find(SearchKey::make(text), matches, cancel);
+            },
+            [&grid](const std::string& text, std::vector<size_t>& matches) {
+                if (text.empty()) {
+                    grid->showAllBoxes();
+                } else {
+                    grid->setVisibleBoxes(matches);
+                }
+            });
+        backend->addFd(searchWorker.eventFd(), [&searchWorker] {
+            searchWorker.dispatch();
+        });
+        
+        // 13. Setup search box callbacks
+        searchBox->setOnTextChanged([&searchWorker](const std::string& text) {
             std::cout << "Search: " << text << std::endl;
+            searchWorker.submit(text);
         });
         
         searchBox->setOnSearchSubmitted([](const std::string& query) {
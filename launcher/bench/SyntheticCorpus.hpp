@@ -0,0 +1,155 @@
+#ifndef SYNTHETIC_CORPUS_HPP
+#define SYNTHETIC_CORPUS_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// Temporary directory filled with generated .desktop files, removed on destruction
+class SyntheticCorpus {
+  public:
+    explicit SyntheticCorpus(size_t count, uint32_t seed = 1) : m_count(count), m_state(seed) {
+        m_root = fs::temp_directory_path() /
+                 ("launcher-bench-" + std::to_string(::getpid()) + "-" + std::to_string(count));
+        fs::remove_all(m_root);
+        fs::create_directories(applicationsDir());
+
+        for (size_t i = 0; i < count; ++i) {
+            writeEntry(i);
+        }
+    }
+
+    ~SyntheticCorpus() {
+        std::error_code ec;
+        fs::remove_all(m_root, ec);
+    }
+
+    SyntheticCorpus(const SyntheticCorpus&) = delete;
+    SyntheticCorpus& operator=(const SyntheticCorpus&) = delete;
+
+    fs::path applicationsDir() const { return m_root / "applications"; }
+    size_t size() const { return m_count; }
+
+    // Words names are built from, so benchmarks can derive queries that hit
+    static constexpr const char* WORDS[] = {
+        "Fire", "Code", "Term", "Office", "Image", "Music", "Video", "Mail",
+        "Chat", "Studio", "Viewer", "Editor", "Player", "Manager", "Monitor", "Writer",
+    };
+    static constexpr size_t WORD_COUNT = sizeof(WORDS) / sizeof(WORDS[0]);
+
+  private:
+    uint32_t next() {
+        // xorshift32: deterministic across runs so timings are comparable
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+    std::string word() { return WORDS[next() % WORD_COUNT]; }
+
+    // Locale suffixes with a translated word each; the non-ASCII ones keep
+    // multi-byte UTF-8 in the key/value paths the parser has to skip
+    static constexpr const char* LOCALES[][2] = {
+        {"de", "Bearbeiter"}, {"fr", "Éditeur"}, {"es", "Reproductor"}, {"it", "Visualizzatore"},
+        {"pt_BR", "Gerenciador"}, {"ru", "Редактор"}, {"ja", "エディター"}, {"zh_CN", "编辑器"},
+        {"ko", "편집기"}, {"pl", "Odtwarzacz"}, {"nl", "Weergave"}, {"sv", "Hanterare"},
+        {"tr", "Düzenleyici"}, {"uk", "Переглядач"}, {"cs", "Přehrávač"}, {"el", "Επεξεργαστής"},
+        {"ar", "محرر"}, {"he", "עורך"}, {"fi", "Muokkain"}, {"hu", "Szerkesztő"},
+        {"da", "Afspiller"}, {"nb", "Redigering"}, {"ro", "Editor"}, {"vi", "Trình soạn"},
+    };
+    static constexpr size_t LOCALE_COUNT = sizeof(LOCALES) / sizeof(LOCALES[0]);
+
+    // Roughly what /usr/share/applications looks like on a desktop install:
+    // most entries are translated, a few big projects into every locale, and
+    // a fair share carry vendor groups and desktop actions after the main group
+    size_t translationCount() {
+        uint32_t roll = next() % 100;
+        if (roll < 30) return 0;
+        if (roll < 60) return 1 + next() % 4;
+        if (roll < 90) return 5 + next() % 10;
+        return LOCALE_COUNT;
+    }
+
+    void writeLocalized(std::ofstream& out, const char* key, const std::string& value, size_t locales) {
+        for (size_t i = 0; i < locales; ++i) {
+            out << key << "[" << LOCALES[i][0] << "]=" << LOCALES[i][1] << " " << value << "\n";
+        }
+    }
+
+    void writeEntry(size_t index) {
+        std::string id = "app" + std::to_string(index);
+        std::string name = word() + " " + word() + " " + std::to_string(index);
+        std::string genericName = word() + " " + word();
+        std::string comment = "The " + word() + " " + word() + " for your desktop";
+        size_t locales = translationCount();
+
+        std::ofstream out(applicationsDir() / (id + ".desktop"));
+        out << "# Generated for launcher benchmarks\n";
+        out << "[Desktop Entry]\n";
+        out << "Type=Application\n";
+        out << "Version=1.5\n";
+        out << "Name=" << name << "\n";
+        writeLocalized(out, "Name", name, locales);
+        out << "GenericName=" << genericName << "\n";
+        writeLocalized(out, "GenericName", genericName, locales);
+        out << "Comment=" << comment << "\n";
+        writeLocalized(out, "Comment", comment, locales);
+        out << "Exec=/usr/bin/" << id << " %U\n";
+        out << "TryExec=" << id << "\n";
+        out << "Icon=" << id << "\n";
+        out << "Terminal=false\n";
+        out << "Categories=Utility;" << word() << ";\n";
+        out << "Keywords=" << word() << ";" << word() << ";" << word() << ";\n";
+        if (next() % 3 == 0) {
+            out << "MimeType=";
+            for (uint32_t i = 0, n = 2 + next() % 20; i < n; ++i) {
+                out << "application/x-" << id << "-" << i << ";";
+            }
+            out << "\n";
+        }
+        if (next() % 4 == 0) {
+            out << "StartupNotify=true\nStartupWMClass=" << id << "\n";
+        }
+        if (next() % 10 == 0) {
+            out << (next() % 2 ? "OnlyShowIn=GNOME;\n" : "NotShowIn=KDE;\n");
+        }
+        if (next() % 20 == 0) {
+            out << "NoDisplay=true\n";
+        }
+        if (next() % 100 == 0) {
+            out << "Hidden=true\n";
+        }
+
+        if (next() % 4 == 0) {
+            out << "X-GNOME-UsesNotifications=true\n";
+            out << "X-KDE-Protocols=file;http;https;\n";
+            out << "X-Flatpak-RenamedFrom=" << id << "-legacy.desktop;\n";
+        }
+
+        // Junk groups: the parser must stop at the first one
+        for (uint32_t i = 0, n = next() % 3; i < n; ++i) {
+            out << "\n[Desktop Action action" << i << "]\n";
+            out << "Name=" << word() << " " << word() << "\n";
+            writeLocalized(out, "Name", "Action", locales);
+            out << "Exec=/usr/bin/" << id << " --action" << i << "\n";
+        }
+        if (next() % 8 == 0) {
+            out << "\n[X-Vendor Metadata]\n";
+            out << "Name=Vendor " << word() << "\n";
+            out << "Exec=/bin/false\n";
+            out << "Payload=" << std::string(64 + next() % 512, 'x') << "\n";
+        }
+    }
+
+    size_t m_count;
+    uint32_t m_state;
+    fs::path m_root;
+};
+
+#endif // SYNTHETIC_CORPUS_HPP
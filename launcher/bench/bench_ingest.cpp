@@ -0,0 +1,137 @@
+// Desktop-entry ingestion scaling: serial vs. worker pool on synthetic corpora.
+//
+// The index cache is disabled so every run parses the full corpus. Each
+// configuration is checked against the serial result to make sure the
+// parallel path produces identical output. A second table splits lazy
+// loading into the list phase, which gates the first frame, and the detail
+// pass that runs afterwards.
+
+#include "AppDatabase.hpp"
+#include "SyntheticCorpus.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int RUNS = 5;
+
+double loadMs(const fs::path& dir, size_t workers, std::vector<DesktopApp>* out = nullptr) {
+    AppDatabase::LoadOptions options;
+    options.directories = {dir};
+    options.useIndex = false;
+    options.lazyDetails = false;
+    // The corpus names programs that are not installed
+    options.checkTryExec = false;
+    options.workerCount = workers;
+    options.watch = false;
+    options.trackUsage = false;
+    options.verbose = false;
+
+    auto start = std::chrono::steady_clock::now();
+    AppDatabase db(options);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    if (out) {
+        out->clear();
+        for (AppStore::AppId id : db.apps().sorted()) {
+            out->push_back(db.apps().materialize(id));
+        }
+    }
+    return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+double medianMs(const fs::path& dir, size_t workers) {
+    std::vector<double> samples;
+    for (int i = 0; i < RUNS; ++i) {
+        samples.push_back(loadMs(dir, workers));
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+struct PhaseTimes {
+    double listMs = 0;
+    double detailMs = 0;
+};
+
+PhaseTimes lazyPhases(const fs::path& dir) {
+    AppDatabase::LoadOptions options;
+    options.directories = {dir};
+    options.useIndex = false;
+    options.lazyDetails = true;
+    options.checkTryExec = false;
+    options.watch = false;
+    options.trackUsage = false;
+    options.verbose = false;
+
+    PhaseTimes times;
+    auto start = std::chrono::steady_clock::now();
+    AppDatabase db(options);
+    auto listed = std::chrono::steady_clock::now();
+    db.loadDetails(SIZE_MAX);
+    auto done = std::chrono::steady_clock::now();
+
+    times.listMs = std::chrono::duration<double, std::milli>(listed - start).count();
+    times.detailMs = std::chrono::duration<double, std::milli>(done - listed).count();
+    return times;
+}
+
+} // namespace
+
+int main() {
+    const size_t hw = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> workerCounts = {1, 2, 4, 8};
+    if (std::find(workerCounts.begin(), workerCounts.end(), hw) == workerCounts.end()) {
+        workerCounts.push_back(hw);
+    }
+
+    std::printf("%-8s %-8s %12s %9s\n", "entries", "workers", "median ms", "speedup");
+
+    for (size_t count : {1000, 10000, 50000}) {
+        SyntheticCorpus corpus(count);
+
+        // Warm the page cache and capture the reference output
+        std::vector<DesktopApp> serial;
+        loadMs(corpus.applicationsDir(), 1, &serial);
+
+        double baseline = 0;
+        for (size_t workers : workerCounts) {
+            std::vector<DesktopApp> result;
+            loadMs(corpus.applicationsDir(), workers, &result);
+            if (result != serial) {
+                std::cerr << "Mismatch: " << workers << " workers differ from serial output at "
+                          << count << " entries" << std::endl;
+                return 1;
+            }
+
+            double ms = medianMs(corpus.applicationsDir(), workers);
+            if (workers == 1) baseline = ms;
+            std::printf("%-8zu %-8zu %12.2f %8.2fx\n", count, workers, ms, baseline / ms);
+        }
+    }
+
+    std::printf("\n%-8s %10s %12s %12s\n", "entries", "eager ms", "list ms", "details ms");
+
+    for (size_t count : {1000, 10000, 50000}) {
+        SyntheticCorpus corpus(count);
+        loadMs(corpus.applicationsDir(), 0);
+
+        double eager = medianMs(corpus.applicationsDir(), 0);
+        std::vector<PhaseTimes> samples;
+        for (int i = 0; i < RUNS; ++i) {
+            samples.push_back(lazyPhases(corpus.applicationsDir()));
+        }
+        std::sort(samples.begin(), samples.end(),
+                  [](const PhaseTimes& a, const PhaseTimes& b) { return a.listMs < b.listMs; });
+        const auto& median = samples[samples.size() / 2];
+
+        std::printf("%-8zu %10.2f %12.2f %12.2f\n", count, eager, median.listMs, median.detailMs);
+    }
+
+    return 0;
+}
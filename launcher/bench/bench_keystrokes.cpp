@@ -0,0 +1,432 @@
+// Keystroke latency of the launcher's query -> filter -> view-update path.
+//
+// Typing sessions are replayed through what AppLauncher does per edit of
+// the search box: AppSearch answers the query, and a ResultView updates
+// the result items through a stand-in backend whose elements mirror the
+// trees ListAppItem and GridAppItem build, minus the drawing, in a
+// viewport as tall as the launcher's. For every keystroke this reports the
+// median latency of the search and of the view update, the heap
+// allocations they made, the items built, rebound, removed and kept, and
+// the elements built and destroyed, so changes to filterApps(), updateView()
+// or the item classes can be judged on numbers.
+//
+// Sessions use '\b' for backspace, and text in braces arrives in one
+// keystroke, as a paste does. Recorded sessions can be given in a file,
+// one per line with "\b" written out:
+//
+//   bench-keystrokes [--grid] [--entries N] [sessions.txt]
+
+#include "AppSearch.hpp"
+#include "ResultView.hpp"
+#include "SyntheticCorpus.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Counted by the replaced global operator new below
+size_t g_allocations = 0;
+
+size_t g_elementsBuilt = 0;
+size_t g_elementsDestroyed = 0;
+
+} // namespace
+
+// Kept out of line, so GCC does not pair the inlined free() with new
+[[gnu::noinline]] void* operator new(size_t size) {
+    ++g_allocations;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+constexpr int RUNS = 11;
+
+struct Session {
+    const char* name;
+    const char* keys;
+};
+
+const Session SESSIONS[] = {
+    {"burst", "code studio"},
+    {"burst", "fire\b\b\bilm\b\b\bire office"},
+    {"backspace storm", "music player\b\b\b\b\b\b\b\b\b\b\b\bvideo viewer\b\b\b\b\b\b\b\b\b\b\b\b"},
+    {"paste", "{image editor manager}\b\b\b\b\b\b\b\b"},
+    {"paste", "mail {chat studio monitor writer 12}"},
+};
+
+// A heap object per element, as the hyprtoolkit builders produce
+struct StandInElement {
+    StandInElement() { ++g_elementsBuilt; }
+    ~StandInElement() { ++g_elementsDestroyed; }
+
+    StandInElement(const StandInElement&) = delete;
+    StandInElement& operator=(const StandInElement&) = delete;
+
+    void addChild(std::shared_ptr<StandInElement> child) { children.push_back(std::move(child)); }
+
+    std::vector<std::shared_ptr<StandInElement>> children;
+    std::string text;
+    bool active = false;
+};
+
+using ElementPtr = std::shared_ptr<StandInElement>;
+
+ElementPtr element(std::string_view text = {}) {
+    auto result = std::make_shared<StandInElement>();
+    result->text = text;
+    return result;
+}
+
+// Builds the element tree of ListAppItem or GridAppItem and keeps their
+// two callbacks. Rebinding replaces the icon and sets the text, as
+// ListAppItem::bind() and GridAppItem::bind() do.
+class StandInItem {
+  public:
+    StandInItem(const AppStore& store, size_t index, AppStore::AppId appId, bool grid,
+                std::function<void(size_t)> onHover, std::function<void(size_t)> onClick)
+        : m_store(store), m_index(index), m_appId(appId), m_version(store.version(appId)),
+          m_onHover(std::move(onHover)), m_onClick(std::move(onClick)) {
+        m_background = element();
+        m_icon = element();
+        m_text = element(store.name(appId));
+        if (!grid) {
+            m_iconParent = element();
+            m_iconParent->addChild(m_icon);
+            m_iconParent->addChild(m_text);
+            m_background->addChild(m_iconParent);
+            return;
+        }
+
+        auto column = element();
+        column->addChild(element());
+        m_iconParent = element();
+        m_iconParent->addChild(element());
+        m_iconParent->addChild(m_icon);
+        m_iconParent->addChild(element());
+        column->addChild(m_iconParent);
+        column->addChild(element());
+        auto textContainer = element();
+        textContainer->addChild(element());
+        textContainer->addChild(m_text);
+        textContainer->addChild(element());
+        column->addChild(textContainer);
+        m_background->addChild(column);
+    }
+
+    void bind(size_t index, AppStore::AppId appId) {
+        m_index = index;
+        const uint32_t version = m_store.version(appId);
+        if (appId == m_appId && version == m_version) return;
+        m_appId = appId;
+        m_version = version;
+
+        m_text->text = m_store.name(appId);
+        auto icon = element();
+        std::replace(m_iconParent->children.begin(), m_iconParent->children.end(), m_icon, icon);
+        m_icon = std::move(icon);
+    }
+
+    ElementPtr getElement() const { return m_background; }
+    AppStore::AppId getAppId() const { return m_appId; }
+    uint32_t getVersion() const { return m_version; }
+    void setActive(bool active) { m_background->active = active; }
+
+  private:
+    const AppStore& m_store;
+    size_t m_index;
+    AppStore::AppId m_appId;
+    uint32_t m_version;
+    ElementPtr m_background;
+    ElementPtr m_iconParent;
+    ElementPtr m_icon;
+    ElementPtr m_text;
+    std::function<void(size_t)> m_onHover;
+    std::function<void(size_t)> m_onClick;
+};
+
+// Same layout work as AppLauncher::ViewHost, with a fixed viewport
+struct StandInHost {
+    using ItemPtr = std::shared_ptr<StandInItem>;
+
+    static constexpr float VIEWPORT_HEIGHT = 500.F;
+
+    const AppStore& store;
+    bool grid = false;
+    size_t columns = 6;
+
+    ElementPtr scrollArea = element();
+    ElementPtr container;
+    size_t selected = 0;
+
+    uint32_t version(AppStore::AppId appId) const { return store.version(appId); }
+
+    ItemPtr makeItem(size_t index, AppStore::AppId appId) {
+        return std::make_shared<StandInItem>(
+            store, index, appId, grid, [this](size_t result) { selected = result; },
+            [this](size_t result) { selected = result; });
+    }
+
+    void bindItem(const ItemPtr& item, size_t index, AppStore::AppId appId) { item->bind(index, appId); }
+
+    GridGeometry beginLayout(size_t) {
+        if (!container) {
+            container = element();
+            scrollArea->addChild(container);
+        }
+        // ListAppItem's pitch, and ConfigManager's default grid cells
+        return grid ? GridGeometry{columns, 130.F} : GridGeometry{1, 52.F};
+    }
+
+    void placeItem(const ItemPtr& item, size_t) { container->addChild(item->getElement()); }
+
+    void moveItem(const ItemPtr& item, size_t index) { item->bind(index, item->getAppId()); }
+
+    void removeItem(const ItemPtr& item) {
+        auto& children = container->children;
+        children.erase(std::find(children.begin(), children.end(), item->getElement()));
+    }
+};
+
+// AppLauncher's state between keystrokes, minus the toolkit
+class StandInLauncher {
+  public:
+    StandInLauncher(const AppDatabase& db, bool grid) : m_search(db), m_host{db.apps(), grid}, m_view(m_host) {}
+
+    void search(const std::string& query) {
+        const auto& results = m_search.search(query);
+        // A refresh that changed nothing keeps the current items
+        m_changed = !(query == m_shownQuery && results == m_filteredApps);
+        if (m_changed) {
+            m_shownQuery = query;
+            m_filteredApps.assign(results.begin(), results.end());
+        }
+    }
+
+    void updateView() {
+        if (!m_changed) return;
+
+        if (m_filteredApps.empty()) {
+            m_host.scrollArea->children.clear();
+            m_host.container.reset();
+            m_view.clear();
+            m_host.scrollArea->addChild(element("No applications found"));
+            return;
+        }
+
+        if (!m_host.container) m_host.scrollArea->children.clear();
+        m_view.show(m_filteredApps, StandInHost::VIEWPORT_HEIGHT);
+        m_view.setActive(0);
+    }
+
+    size_t results() const { return m_filteredApps.size(); }
+    ResultView<StandInHost>::Stats stats() const { return m_view.stats(); }
+
+  private:
+    AppSearch m_search;
+    StandInHost m_host;
+    ResultView<StandInHost> m_view;
+
+    std::vector<AppStore::AppId> m_filteredApps;
+    std::string m_shownQuery;
+    bool m_changed = false;
+};
+
+struct Keystroke {
+    std::string query;
+    size_t results = 0;
+    double searchUs = 0;
+    double viewUs = 0;
+    size_t allocations = 0;
+    size_t itemsBuilt = 0;
+    size_t itemsRebound = 0;
+    size_t itemsRemoved = 0;
+    size_t itemsKept = 0;
+    size_t elementsBuilt = 0;
+    size_t elementsDestroyed = 0;
+};
+
+double median(std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+// The query after each keystroke of `keys`
+std::vector<std::string> queriesOf(std::string_view keys) {
+    std::vector<std::string> queries;
+    std::string query;
+    bool pasting = false;
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const char c = keys[i];
+        if (c == '{' && !pasting) {
+            pasting = true;
+            continue;
+        }
+        if (c == '}' && pasting) {
+            pasting = false;
+        } else if (c == '\b' || (c == '\\' && i + 1 < keys.size() && keys[i + 1] == 'b')) {
+            if (c == '\\') ++i;
+            if (!query.empty()) query.pop_back();
+        } else {
+            query.push_back(c);
+            if (pasting) continue;
+        }
+        queries.push_back(query);
+    }
+    return queries;
+}
+
+// Replay `keys` RUNS times on fresh launchers. Latencies are medians; the
+// counts come from the last run, when every cache is as warm as in use.
+std::vector<Keystroke> replay(const AppDatabase& db, std::string_view keys, bool grid) {
+    const auto queries = queriesOf(keys);
+    std::vector<Keystroke> keystrokes(queries.size());
+    std::vector<std::vector<double>> searchUs(queries.size()), viewUs(queries.size());
+
+    for (int run = 0; run < RUNS; ++run) {
+        StandInLauncher launcher(db, grid);
+
+        for (size_t i = 0; i < queries.size(); ++i) {
+            const size_t allocations = g_allocations;
+            const size_t elementsBuilt = g_elementsBuilt;
+            const size_t elementsDestroyed = g_elementsDestroyed;
+            const auto stats = launcher.stats();
+
+            auto start = std::chrono::steady_clock::now();
+            launcher.search(queries[i]);
+            auto mid = std::chrono::steady_clock::now();
+            launcher.updateView();
+            auto end = std::chrono::steady_clock::now();
+
+            searchUs[i].push_back(std::chrono::duration<double, std::micro>(mid - start).count());
+            viewUs[i].push_back(std::chrono::duration<double, std::micro>(end - mid).count());
+
+            auto& keystroke = keystrokes[i];
+            keystroke.query = queries[i];
+            keystroke.results = launcher.results();
+            keystroke.allocations = g_allocations - allocations;
+            const auto now = launcher.stats();
+            keystroke.itemsBuilt = now.built - stats.built;
+            keystroke.itemsRebound = now.rebound - stats.rebound;
+            keystroke.itemsRemoved = now.released - stats.released;
+            keystroke.itemsKept = now.kept + now.moved - stats.kept - stats.moved;
+            keystroke.elementsBuilt = g_elementsBuilt - elementsBuilt;
+            keystroke.elementsDestroyed = g_elementsDestroyed - elementsDestroyed;
+        }
+    }
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        keystrokes[i].searchUs = median(searchUs[i]);
+        keystrokes[i].viewUs = median(viewUs[i]);
+    }
+    return keystrokes;
+}
+
+std::string shown(const std::string& query) {
+    constexpr size_t WIDTH = 22;
+    std::string result = "\"" + query + "\"";
+    if (result.size() > WIDTH) result = "\"..." + query.substr(query.size() - (WIDTH - 5)) + "\"";
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool grid = false;
+    size_t entries = 10000;
+    std::vector<Session> sessions(std::begin(SESSIONS), std::end(SESSIONS));
+    std::vector<std::string> recorded;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--grid") == 0) {
+            grid = true;
+        } else if (std::strcmp(argv[i], "--entries") == 0 && i + 1 < argc) {
+            entries = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            std::ifstream file(argv[i]);
+            if (!file) {
+                std::cerr << "Cannot read sessions from " << argv[i] << std::endl;
+                return 1;
+            }
+            for (std::string line; std::getline(file, line);) {
+                if (!line.empty()) recorded.push_back(line);
+            }
+        }
+    }
+    if (!recorded.empty()) {
+        sessions.clear();
+        for (const auto& keys : recorded) sessions.push_back({"recorded", keys.c_str()});
+    }
+
+    SyntheticCorpus corpus(entries);
+
+    AppDatabase::LoadOptions options;
+    options.directories = {corpus.applicationsDir()};
+    options.useIndex = false;
+    options.lazyDetails = false;
+    // The corpus names programs that are not installed
+    options.checkTryExec = false;
+    options.watch = false;
+    options.trackUsage = false;
+    options.verbose = false;
+    AppDatabase db(options);
+
+    std::printf("%zu entries, %s view, median of %d runs\n", db.apps().size(), grid ? "grid" : "list", RUNS);
+
+    Keystroke total;
+    size_t count = 0;
+    double worstUs = 0;
+    for (const auto& session : sessions) {
+        std::printf("\n%s\n%-24s %8s %10s %10s %8s %8s %8s %8s %8s %10s %10s\n", session.name, "query", "results",
+                    "search us", "view us", "allocs", "items+", "items~", "items-", "items=", "elements+",
+                    "elements-");
+
+        for (const auto& keystroke : replay(db, session.keys, grid)) {
+            std::printf("%-24s %8zu %10.1f %10.1f %8zu %8zu %8zu %8zu %8zu %10zu %10zu\n",
+                        shown(keystroke.query).c_str(), keystroke.results, keystroke.searchUs, keystroke.viewUs,
+                        keystroke.allocations, keystroke.itemsBuilt, keystroke.itemsRebound, keystroke.itemsRemoved,
+                        keystroke.itemsKept, keystroke.elementsBuilt, keystroke.elementsDestroyed);
+
+            total.searchUs += keystroke.searchUs;
+            total.viewUs += keystroke.viewUs;
+            total.allocations += keystroke.allocations;
+            total.itemsBuilt += keystroke.itemsBuilt;
+            total.itemsRebound += keystroke.itemsRebound;
+            total.itemsRemoved += keystroke.itemsRemoved;
+            total.itemsKept += keystroke.itemsKept;
+            total.elementsBuilt += keystroke.elementsBuilt;
+            worstUs = std::max(worstUs, keystroke.searchUs + keystroke.viewUs);
+            ++count;
+        }
+    }
+
+    const double n = static_cast<double>(count);
+    std::printf("\n%zu keystrokes: %.1f us search + %.1f us view per key (worst %.1f us), "
+                "%.0f allocations, %.1f items built, %.1f rebound, %.1f removed, %.1f kept, "
+                "%.0f elements built per key\n",
+                count, total.searchUs / n, total.viewUs / n, worstUs, static_cast<double>(total.allocations) / n,
+                static_cast<double>(total.itemsBuilt) / n, static_cast<double>(total.itemsRebound) / n,
+                static_cast<double>(total.itemsRemoved) / n, static_cast<double>(total.itemsKept) / n,
+                static_cast<double>(total.elementsBuilt) / n);
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Keystroke replay: full rescans vs. AppSearch's incremental refinement.
+//
+// Typing sessions are replayed one keystroke at a time ('\b' is backspace).
+// Every keystroke is answered both by filterApps() over the whole database
+// and by an AppSearch that narrows the previous result set, both ranked the
+// same way, and the two answers are compared before any timing is reported. The per-keystroke
+// table shows the number of apps each approach had to test.
+
+#include "AppSearch.hpp"
+#include "SyntheticCorpus.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int RUNS = 21;
+
+const char* SESSIONS[] = {
+    "editor",
+    "monitor\b\b\b\b\b\banager",
+    "player 12",
+    "code\b\b\b\bchat\b\b\b\bstudio",
+};
+
+struct Keystroke {
+    std::string query;
+    size_t results = 0;
+    size_t fullScanned = 0;
+    size_t incrementalScanned = 0;
+    double fullUs = 0;
+    double incrementalUs = 0;
+};
+
+double median(std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+// Replay one session RUNS times; returns false if the answers ever differ
+bool replay(const AppDatabase& db, const char* session, std::vector<Keystroke>& keystrokes) {
+    std::vector<std::string> queries;
+    std::string query;
+    for (const char* c = session; *c; ++c) {
+        if (*c == '\b') {
+            query.pop_back();
+        } else {
+            query.push_back(*c);
+        }
+        queries.push_back(query);
+    }
+
+    std::vector<std::vector<double>> full(queries.size()), incremental(queries.size());
+    std::vector<AppStore::AppId> matches;
+    std::vector<AppStore::AppId> expected;
+    keystrokes.assign(queries.size(), {});
+
+    for (int run = 0; run < RUNS; ++run) {
+        AppSearch search(db);
+
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto start = std::chrono::steady_clock::now();
+            db.filterApps(queries[i], matches);
+            db.rankApps(queries[i], matches, AppSearch::DEFAULT_RANK_LIMIT, expected);
+            auto mid = std::chrono::steady_clock::now();
+            const auto& results = search.search(queries[i]);
+            auto end = std::chrono::steady_clock::now();
+
+            if (results != expected) {
+                std::cerr << "Mismatch: \"" << queries[i] << "\" refined to " << results.size()
+                          << " apps, a full scan finds " << expected.size() << std::endl;
+                return false;
+            }
+
+            full[i].push_back(std::chrono::duration<double, std::micro>(mid - start).count());
+            incremental[i].push_back(std::chrono::duration<double, std::micro>(end - mid).count());
+
+            auto& keystroke = keystrokes[i];
+            keystroke.query = queries[i];
+            keystroke.results = results.size();
+            keystroke.fullScanned = db.apps().size();
+            keystroke.incrementalScanned = search.lastScanned();
+        }
+    }
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        keystrokes[i].fullUs = median(full[i]);
+        keystrokes[i].incrementalUs = median(incremental[i]);
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    std::printf("%-8s %-10s %12s %12s %14s %14s %9s\n", "entries", "keystrokes", "full us/key",
+                "incr us/key", "full scanned", "incr scanned", "speedup");
+
+    for (size_t count : {1000, 10000, 50000}) {
+        SyntheticCorpus corpus(count);
+
+        AppDatabase::LoadOptions options;
+        options.directories = {corpus.applicationsDir()};
+        options.useIndex = false;
+        options.lazyDetails = false;
+        // The corpus names programs that are not installed
+        options.checkTryExec = false;
+        options.watch = false;
+        options.trackUsage = false;
+        options.verbose = false;
+        AppDatabase db(options);
+
+        std::vector<Keystroke> all;
+        std::vector<Keystroke> keystrokes;
+        for (const char* session : SESSIONS) {
+            if (!replay(db, session, keystrokes)) return 1;
+            all.insert(all.end(), keystrokes.begin(), keystrokes.end());
+        }
+
+        double fullUs = 0, incrementalUs = 0;
+        size_t fullScanned = 0, incrementalScanned = 0;
+        for (const auto& keystroke : all) {
+            fullUs += keystroke.fullUs;
+            incrementalUs += keystroke.incrementalUs;
+            fullScanned += keystroke.fullScanned;
+            incrementalScanned += keystroke.incrementalScanned;
+        }
+
+        const double n = static_cast<double>(all.size());
+        std::printf("%-8zu %-10zu %12.2f %12.2f %14.0f %14.0f %8.2fx\n", count, all.size(), fullUs / n,
+                    incrementalUs / n, static_cast<double>(fullScanned) / n,
+                    static_cast<double>(incrementalScanned) / n, fullUs / incrementalUs);
+
+        // Keystroke by keystroke for the largest corpus
+        if (count == 50000) {
+            std::printf("\n%-16s %8s %8s %10s %10s\n", "query", "results", "scanned", "full us", "incr us");
+            for (const auto& keystroke : all) {
+                std::printf("%-16s %8zu %8zu %10.2f %10.2f\n", ("\"" + keystroke.query + "\"").c_str(),
+                            keystroke.results, keystroke.incrementalScanned, keystroke.fullUs,
+                            keystroke.incrementalUs);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,349 @@
+// Headless AppDatabase benchmark suite: load time, peak RSS and filter latency.
+//
+//   bench-suite [--sizes 100,1000,10000,100000] [--kernel scalar|sse2|avx2]
+//               [--json FILE|-]
+//
+// Each corpus size runs in a forked child so peak RSS belongs to that size
+// alone. Load time is the median of several index-less eager loads, plus one
+// pass that reads everything back from a freshly written index. Filter
+// latency is sampled per search, filterApps() plus rankApps() for the first
+// page, over a fixed query mix: single letters, growing word prefixes, full
+// words, digits, misses, and exact queries for the substring kernel.
+//
+// The table goes to stdout; --json writes the same numbers, per query
+// included, for comparing runs.
+
+#include "AppDatabase.hpp"
+#include "AppSearch.hpp"
+#include "SyntheticCorpus.hpp"
+#include "SubstringScan.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps the optimizer from discarding filter results
+volatile size_t g_sink = 0;
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Value of a "Key:   123 kB" line in /proc/self/status, or 0
+long procStatusKb(const char* key) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    const size_t keyLength = std::strlen(key);
+    while (std::getline(status, line)) {
+        if (line.compare(0, keyLength, key) == 0 && line.size() > keyLength && line[keyLength] == ':') {
+            return std::strtol(line.c_str() + keyLength + 1, nullptr, 10);
+        }
+    }
+    return 0;
+}
+
+// Drop the peak RSS back to the current RSS (Linux 4.0+)
+void resetPeakRss() {
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+double percentile(std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+std::string jsonString(std::string_view str) {
+    std::string out = "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        out.push_back(c);
+    }
+    out.push_back('"');
+    return out;
+}
+
+std::vector<std::string> queryMix() {
+    std::vector<std::string> queries = {"", "e", "o", "x", "7", "42", "zzzz", "qxj"};
+
+    for (size_t i = 0; i < SyntheticCorpus::WORD_COUNT; i += 3) {
+        std::string word = SyntheticCorpus::WORDS[i];
+        for (char& c : word) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+
+        // Every prefix, as typed one keystroke at a time
+        for (size_t length = 2; length <= word.size(); ++length) {
+            queries.push_back(word.substr(0, length));
+        }
+        queries.push_back(SyntheticCorpus::WORDS[i]);
+    }
+
+    queries.push_back("code studio");
+    queries.push_back("player 1");
+    queries.push_back("'e");
+    queries.push_back("'42");
+    queries.push_back("'code studio");
+    return queries;
+}
+
+AppDatabase::LoadOptions benchOptions(const fs::path& dir, size_t workers, const fs::path& indexPath = {}) {
+    AppDatabase::LoadOptions options;
+    options.directories = {dir};
+    options.useIndex = !indexPath.empty();
+    options.indexPath = indexPath;
+    options.lazyDetails = false;
+    // The corpus names programs that are not installed
+    options.checkTryExec = false;
+    options.desktops = {"Hyprland"};
+    options.workerCount = workers;
+    options.watch = false;
+    // Keep the machine's launch history out of the numbers
+    options.trackUsage = false;
+    options.verbose = false;
+    return options;
+}
+
+double timedLoad(const fs::path& dir, size_t workers, const fs::path& indexPath = {}) {
+    auto start = Clock::now();
+    AppDatabase db(benchOptions(dir, workers, indexPath));
+    return msSince(start);
+}
+
+// Runs in the child: measures one corpus and returns its table row and JSON
+// object, separated by a newline
+std::string measure(const SyntheticCorpus& corpus, size_t workers) {
+    const fs::path dir = corpus.applicationsDir();
+    const size_t count = corpus.size();
+    const int loadRuns = count >= 100000 ? 3 : 5;
+
+    // Peak RSS of the first load, before anything else has grown the heap
+    resetPeakRss();
+    const long baselineKb = procStatusKb("VmRSS");
+
+    auto start = Clock::now();
+    AppDatabase db(benchOptions(dir, workers));
+    const double firstLoadMs = msSince(start);
+    const long peakKb = procStatusKb("VmHWM");
+    const long residentKb = procStatusKb("VmRSS");
+
+    std::vector<double> loads = {firstLoadMs};
+    for (int i = 1; i < loadRuns; ++i) {
+        loads.push_back(timedLoad(dir, workers));
+    }
+    std::sort(loads.begin(), loads.end());
+
+    // Write the index once, then time reading it back
+    const fs::path indexPath = dir.parent_path() / "index.bin";
+    timedLoad(dir, workers, indexPath);
+    std::vector<double> cachedLoads;
+    for (int i = 0; i < loadRuns; ++i) {
+        cachedLoads.push_back(timedLoad(dir, workers, indexPath));
+    }
+    std::sort(cachedLoads.begin(), cachedLoads.end());
+
+    // Filter latency, one sample per call
+    const size_t reps = std::clamp<size_t>(2000000 / count, 10, 2000);
+    std::vector<AppStore::AppId> matches;
+    std::vector<AppStore::AppId> results;
+    std::vector<double> all;
+    std::string queriesJson;
+
+    for (const auto& query : queryMix()) {
+        db.filterApps(query, matches);
+        db.rankApps(query, matches, AppSearch::DEFAULT_RANK_LIMIT, results);
+
+        std::vector<double> samples;
+        samples.reserve(reps);
+        for (size_t i = 0; i < reps; ++i) {
+            auto callStart = Clock::now();
+            db.filterApps(query, matches);
+            db.rankApps(query, matches, AppSearch::DEFAULT_RANK_LIMIT, results);
+            samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - callStart).count());
+            g_sink = g_sink + results.size();
+        }
+        std::sort(samples.begin(), samples.end());
+        all.insert(all.end(), samples.begin(), samples.end());
+
+        char buffer[256];
+        std::snprintf(buffer, sizeof(buffer),
+                      "%s{\"query\": %s, \"matches\": %zu, \"p50_us\": %.3f, \"p99_us\": %.3f}",
+                      queriesJson.empty() ? "" : ", ", jsonString(query).c_str(), results.size(),
+                      percentile(samples, 0.50), percentile(samples, 0.99));
+        queriesJson += buffer;
+    }
+    std::sort(all.begin(), all.end());
+
+    double mean = 0;
+    for (double sample : all) mean += sample;
+    mean /= static_cast<double>(all.size());
+
+    const double p50 = percentile(all, 0.50);
+    const double p99 = percentile(all, 0.99);
+
+    char row[256];
+    std::snprintf(row, sizeof(row), "%-8zu %-8zu %10.2f %10.2f %10ld %10ld %10.2f %10.2f",
+                  count, db.apps().size(), loads[loads.size() / 2],
+                  cachedLoads[cachedLoads.size() / 2], peakKb, peakKb - baselineKb, p50, p99);
+
+    char json[1024];
+    std::snprintf(json, sizeof(json),
+                  "{\"entries\": %zu, \"listed\": %zu, "
+                  "\"load_ms\": {\"median\": %.3f, \"min\": %.3f, \"first\": %.3f, \"runs\": %zu}, "
+                  "\"cached_load_ms\": {\"median\": %.3f, \"min\": %.3f, \"runs\": %zu}, "
+                  "\"rss_kb\": {\"peak\": %ld, \"resident\": %ld, \"baseline\": %ld, \"peak_delta\": %ld}, "
+                  "\"filter_us\": {\"p50\": %.3f, \"p99\": %.3f, \"mean\": %.3f, \"max\": %.3f, "
+                  "\"samples\": %zu}, ",
+                  count, db.apps().size(), loads[loads.size() / 2], loads.front(), firstLoadMs,
+                  loads.size(), cachedLoads[cachedLoads.size() / 2], cachedLoads.front(),
+                  cachedLoads.size(), peakKb, residentKb, baselineKb, peakKb - baselineKb, p50, p99,
+                  mean, all.back(), all.size());
+
+    return std::string(row) + "\n" + json + "\"queries\": [" + queriesJson + "]}";
+}
+
+// Fork, measure in the child, and collect what it wrote to the pipe
+bool measureInChild(size_t count, size_t workers, std::string& row, std::string& json) {
+    // Generated up front so the corpus writer's memory is not charged to the load
+    SyntheticCorpus corpus(count);
+
+    int fds[2];
+    if (::pipe(fds) != 0) return false;
+
+    pid_t pid = ::fork();
+    if (pid < 0) return false;
+
+    if (pid == 0) {
+        ::close(fds[0]);
+        std::string out = measure(corpus, workers);
+        size_t written = 0;
+        while (written < out.size()) {
+            ssize_t n = ::write(fds[1], out.data() + written, out.size() - written);
+            if (n <= 0) break;
+            written += static_cast<size_t>(n);
+        }
+        // Skip destructors: the parent owns the corpus directory
+        ::_exit(written == out.size() ? 0 : 1);
+    }
+
+    ::close(fds[1]);
+    std::string out;
+    char buffer[4096];
+    for (ssize_t n; (n = ::read(fds[0], buffer, sizeof(buffer))) > 0;) {
+        out.append(buffer, static_cast<size_t>(n));
+    }
+    ::close(fds[0]);
+
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return false;
+
+    size_t newline = out.find('\n');
+    if (newline == std::string::npos) return false;
+    row = out.substr(0, newline);
+    json = out.substr(newline + 1);
+    return true;
+}
+
+std::vector<size_t> parseSizes(const std::string& list) {
+    std::vector<size_t> sizes;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t comma = list.find(',', pos);
+        if (comma == std::string::npos) comma = list.size();
+        sizes.push_back(std::stoul(list.substr(pos, comma - pos)));
+        pos = comma + 1;
+    }
+    return sizes;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes = {100, 1000, 10000, 100000};
+    std::string jsonPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--sizes" && i + 1 < argc) {
+            sizes = parseSizes(argv[++i]);
+        } else if (arg == "--json" && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (arg == "--kernel" && i + 1 < argc) {
+            std::string name = argv[++i];
+            bool known = false;
+            for (auto kernel : {SubstringScan::Kernel::SCALAR, SubstringScan::Kernel::SSE2,
+                                SubstringScan::Kernel::AVX2}) {
+                if (name == SubstringScan::kernelName(kernel)) {
+                    SubstringScan::setKernel(kernel);
+                    known = true;
+                }
+            }
+            if (!known) {
+                std::cerr << "Unknown kernel: " << name << std::endl;
+                return 2;
+            }
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--sizes N,N,...] [--kernel scalar|sse2|avx2] [--json FILE|-]" << std::endl;
+            return 2;
+        }
+    }
+
+    const char* kernel = SubstringScan::kernelName(SubstringScan::activeKernel());
+
+    const size_t workers = std::max(1u, std::thread::hardware_concurrency());
+
+    // With JSON on stdout the table moves to stderr
+    FILE* table = jsonPath == "-" ? stderr : stdout;
+    std::fprintf(table, "substring kernel: %s\n", kernel);
+    std::fprintf(table, "%-8s %-8s %10s %10s %10s %10s %10s %10s\n", "entries", "listed", "load ms",
+                 "cached ms", "peak kB", "delta kB", "p50 us", "p99 us");
+
+    std::vector<std::string> results;
+    for (size_t count : sizes) {
+        std::string row, json;
+        if (!measureInChild(count, workers, row, json)) {
+            std::cerr << "Error: measuring " << count << " entries failed" << std::endl;
+            return 1;
+        }
+        std::fprintf(table, "%s\n", row.c_str());
+        std::fflush(table);
+        results.push_back(std::move(json));
+    }
+
+    if (jsonPath.empty()) return 0;
+
+    std::string doc = "{\"benchmark\": \"launcher-appdatabase\", \"schema\": 1, ";
+    doc += "\"hardware_threads\": " + std::to_string(workers) + ", ";
+    doc += "\"kernel\": \"" + std::string(kernel) + "\", \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        doc += "  " + results[i] + (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    doc += "]}\n";
+
+    if (jsonPath == "-") {
+        std::fputs(doc.c_str(), stdout);
+    } else {
+        std::ofstream out(jsonPath);
+        out << doc;
+        if (!out) {
+            std::cerr << "Error: could not write " << jsonPath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
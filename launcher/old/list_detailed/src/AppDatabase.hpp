@@ -7,7 +7,14 @@
 #include <algorithm>
 #include <thread>
 #include <future>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
 
+// Categories are interned when the apps are loaded: every distinct entry of
+// a Categories= list gets a bit, and each app keeps a bitset of its own, so
+// filtering by category is one AND per app and "Game" never matches
+// "GameEngine". Each load is a new generation.
 class AppDatabase {
 public:
     AppDatabase() {
@@ -47,13 +54,29 @@ public:
             return m_allApps;
         }
         
+        // The word and bit every app of `category` has set
+        size_t categoryWord = 0;
+        uint64_t categoryBit = 0;
+        if (!category.empty()) {
+            auto it = m_categoryBits.find(category);
+            if (it == m_categoryBits.end()) return {};
+            categoryWord = it->second / 64;
+            categoryBit = uint64_t{1} << (it->second % 64);
+        }
+        
         std::string lowerQuery = query;
         std::transform(lowerQuery.begin(), lowerQuery.end(), 
                        lowerQuery.begin(), ::tolower);
         
         std::vector<DesktopApp> filtered;
-        for (const auto& app : m_allApps) {
-            bool matches = true;
+        for (size_t i = 0; i < m_allApps.size(); ++i) {
+            const auto& app = m_allApps[i];
+            
+            // Tested first, since it costs nothing next to the text match
+            if (categoryBit && 
+                !(m_appCategories[i * m_categoryWords + categoryWord] & categoryBit)) {
+                continue;
+            }
             
             if (!query.empty()) {
                 std::string lowerName = app.name;
@@ -64,51 +87,46 @@ public:
                 std::transform(lowerComment.begin(), lowerComment.end(), 
                              lowerComment.begin(), ::tolower);
                 
-                matches = (lowerName.find(lowerQuery) != std::string::npos) ||
-                         (lowerComment.find(lowerQuery) != std::string::npos);
-            }
-            
-            if (!category.empty() && matches) {
-                matches = (app.categories.find(category) != std::string::npos);
+                if (lowerName.find(lowerQuery) == std::string::npos &&
+                    lowerComment.find(lowerQuery) == std::string::npos) {
+                    continue;
+                }
             }
             
-            if (matches) {
-                filtered.push_back(app);
-            }
+            filtered.push_back(app);
         }
         
         return filtered;
     }
     
-    std::vector<std::string> getAllCategories() const {
+    // Sorted names of every category, built once per generation. The list
+    // is shared, so holding on to it costs no copy and survives a reload.
+    std::shared_ptr<const std::vector<std::string>> getAllCategories() const {
         std::lock_guard<std::mutex> lock(m_mutex);
         
-        std::vector<std::string> categories;
-        for (const auto& app : m_allApps) {
-            size_t start = 0;
-            while (start < app.categories.length()) {
-                size_t end = app.categories.find(';', start);
-                std::string category = app.categories.substr(
-                    start, end - start);
-                
-                if (!category.empty() && 
-                    std::find(categories.begin(), categories.end(), 
-                             category) == categories.end()) {
-                    categories.push_back(category);
-                }
-                
-                if (end == std::string::npos) break;
-                start = end + 1;
-            }
+        if (!m_sortedCategories || m_sortedCategoriesGeneration != m_generation) {
+            auto sorted = std::make_shared<std::vector<std::string>>(m_categoryNames);
+            std::sort(sorted->begin(), sorted->end());
+            m_sortedCategories = std::move(sorted);
+            m_sortedCategoriesGeneration = m_generation;
         }
-        
-        std::sort(categories.begin(), categories.end());
-        return categories;
+        return m_sortedCategories;
+    }
+    
+    // Bumped by every load and reload
+    uint64_t generation() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_generation;
     }
     
     void reload() {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_allApps.clear();
+        m_appCategories.clear();
+        m_categoryNames.clear();
+        m_categoryBits.clear();
+        m_categoryWords = 0;
+        ++m_generation;
         m_loaded = false;
         
         m_loadFuture = std::async(std::launch::async, [this] {
@@ -150,9 +168,34 @@ private:
         
         std::sort(apps.begin(), apps.end());
         
+        // Intern the categories first so every bitset gets the same width
+        std::vector<std::string> categoryNames;
+        std::unordered_map<std::string, size_t> categoryBits;
+        for (const auto& app : apps) {
+            forEachCategory(app.categories, [&](std::string_view category) {
+                if (categoryBits.try_emplace(std::string(category), categoryNames.size()).second) {
+                    categoryNames.emplace_back(category);
+                }
+            });
+        }
+        
+        const size_t categoryWords = (categoryNames.size() + 63) / 64;
+        std::vector<uint64_t> appCategories(apps.size() * categoryWords);
+        for (size_t i = 0; i < apps.size(); ++i) {
+            forEachCategory(apps[i].categories, [&](std::string_view category) {
+                const size_t bit = categoryBits.find(std::string(category))->second;
+                appCategories[i * categoryWords + bit / 64] |= uint64_t{1} << (bit % 64);
+            });
+        }
+        
         {
             std::lock_guard<std::mutex> lock(m_mutex);
             m_allApps = std::move(apps);
+            m_categoryNames = std::move(categoryNames);
+            m_categoryBits = std::move(categoryBits);
+            m_categoryWords = categoryWords;
+            m_appCategories = std::move(appCategories);
+            ++m_generation;
             m_loaded = true;
         }
         
@@ -160,6 +203,18 @@ private:
                   << " applications" << std::endl;
     }
     
+    // Calls `fn` with each non-empty entry of a Categories= value
+    template <typename Fn>
+    static void forEachCategory(std::string_view categories, Fn&& fn) {
+        while (!categories.empty()) {
+            size_t end = categories.find(';');
+            std::string_view category = categories.substr(0, end);
+            if (!category.empty()) fn(category);
+            if (end == std::string_view::npos) break;
+            categories.remove_prefix(end + 1);
+        }
+    }
+    
     void loadAppsFromDirectory(const fs::path& directory, 
                                std::vector<DesktopApp>& apps) {
         try {
@@ -179,6 +234,18 @@ private:
     
     mutable std::mutex m_mutex;
     std::vector<DesktopApp> m_allApps;
+    
+    // Category names in bit order, and the bit of each name
+    std::vector<std::string> m_categoryNames;
+    std::unordered_map<std::string, size_t> m_categoryBits;
+    // m_categoryWords words per app, in m_allApps order
+    size_t m_categoryWords = 0;
+    std::vector<uint64_t> m_appCategories;
+    
+    uint64_t m_generation = 0;
+    mutable std::shared_ptr<const std::vector<std::string>> m_sortedCategories;
+    mutable uint64_t m_sortedCategoriesGeneration = 0;
+    
     bool m_loaded = false;
     std::future<void> m_loadFuture;
 };
\ No newline at end of file
@@ -270,17 +270,16 @@ private:
             ->commence();
         
         // Category dropdown
-        auto categories = m_appDatabase->getAllCategories();
-        std::vector<std::string> categoryItems = {"All Categories"};
-        categoryItems.insert(categoryItems.end(), 
-                           categories.begin(), categories.end());
+        m_categories = m_appDatabase->getAllCategories();
+        m_categoriesGeneration = m_appDatabase->generation();
         
         m_categoryDropdown = CComboboxBuilder::begin()
-            ->items(std::move(categoryItems))
+            ->items(categoryItems())
             ->currentItem(0)
             ->onChanged([this](CSharedPointer<CComboboxElement>, size_t idx) {
-                m_selectedCategory = (idx == 0) ? "" : 
-                    m_appDatabase->getAllCategories()[idx - 1];
+                // Indexes the list the dropdown was filled from
+                m_selectedCategory = (idx == 0 || idx > m_categories->size()) ? "" : 
+                    (*m_categories)[idx - 1];
                 filterApps(m_currentSearch);
             })
             ->size(CDynamicSize(CDynamicSize::HT_SIZE_ABSOLUTE,
@@ -304,6 +303,33 @@ private:
         
         m_mainLayout->addChild(filterRow);
     }
+    
+    std::vector<std::string> categoryItems() const {
+        std::vector<std::string> items = {"All Categories"};
+        items.insert(items.end(), m_categories->begin(), m_categories->end());
+        return items;
+    }
+    
+    // Refill the dropdown if a reload changed the categories, keeping the
+    // selected one if it still exists
+    void refreshCategories() {
+        if (!m_categoryDropdown || m_categoriesGeneration == m_appDatabase->generation()) return;
+        
+        m_categories = m_appDatabase->getAllCategories();
+        m_categoriesGeneration = m_appDatabase->generation();
+        
+        auto it = std::find(m_categories->begin(), m_categories->end(), m_selectedCategory);
+        size_t current = 0;
+        if (it != m_categories->end()) {
+            current = static_cast<size_t>(it - m_categories->begin()) + 1;
+        } else {
+            m_selectedCategory.clear();
+        }
+        
+        if (auto builder = m_categoryDropdown->rebuild()) {
+            builder->items(categoryItems())->currentItem(current)->commence();
+        }
+    }
     void createAppList() {
         m_scrollArea = CScrollAreaBuilder::begin()
             ->scrollY(true)
@@ -421,6 +447,7 @@ private:
         m_appDatabase->reload();
         m_appDatabase->waitForLoad();
         
+        refreshCategories();
         filterApps(m_currentSearch);
         
         std::cout << "Reload complete. Found " 
@@ -654,6 +681,9 @@ private:
     
     std::string m_currentSearch;
     std::string m_selectedCategory;
+    // What the category dropdown shows, and the generation it came from
+    std::shared_ptr<const std::vector<std::string>> m_categories;
+    uint64_t m_categoriesGeneration = 0;
     size_t m_selectedIndex = 0;
     
     Hyprutils::Signal::CHyprSignalListener m_keyboardListener;
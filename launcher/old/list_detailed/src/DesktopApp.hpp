@@ -1,5 +1,6 @@
 #pragma once
 
+#include "DesktopEntryLines.hpp"
 #include <string>
 #include <vector>
 #include <optional>
@@ -8,6 +9,8 @@
 #include <algorithm>
 #include <cctype>
 #include <iostream>  // ADD THIS
+#include <iterator>
+#include <string_view>
 
 namespace fs = std::filesystem;
 
@@ -63,44 +66,16 @@ struct DesktopApp {
 class DesktopAppParser {
 public:
     static std::optional<DesktopApp> parseDesktopFile(const fs::path& filepath) {
-        std::ifstream file(filepath);
+        std::ifstream file(filepath, std::ios::binary);
         if (!file.is_open()) return std::nullopt;
         
+        std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        
         DesktopApp app;
         app.desktopFile = filepath.string();
         
-        std::string line;
-        bool inDesktopEntry = false;
-        bool hasMainSection = false;
-        
-        while (std::getline(file, line)) {
-            // Remove comments and trim
-            if (line.find('#') != std::string::npos) {
-                line = line.substr(0, line.find('#'));
-            }
-            
-            line.erase(0, line.find_first_not_of(" \t"));
-            line.erase(line.find_last_not_of(" \t") + 1);
-            
-            if (line.empty()) continue;
-            
-            if (line == "[Desktop Entry]") {
-                inDesktopEntry = true;
-                hasMainSection = true;
-                continue;
-            } else if (line[0] == '[') {
-                inDesktopEntry = false;
-                continue;
-            }
-            
-            if (!inDesktopEntry) continue;
-            
-            size_t equalsPos = line.find('=');
-            if (equalsPos == std::string::npos) continue;
-            
-            std::string key = line.substr(0, equalsPos);
-            std::string value = line.substr(equalsPos + 1);
-            
+        // Tokenized in place, as the launcher's DesktopEntryParser does
+        const size_t header = DesktopEntryLines::forEachEntry(data, [&](std::string_view key, std::string_view value) {
             if (key == "Name") {
                 app.name = value;
             } else if (key == "Exec") {
@@ -118,9 +93,9 @@ public:
             } else if (key == "Hidden") {
                 app.hidden = (value == "true");
             }
-        }
+        });
         
-        if (!hasMainSection || app.name.empty() || app.exec.empty() || 
+        if (header == std::string_view::npos || app.name.empty() || app.exec.empty() || 
             app.noDisplay || app.hidden) {
             return std::nullopt;
         }
@@ -0,0 +1,814 @@
+#include "AppDatabase.hpp"
+#include "AppIndexCache.hpp"
+#include "DesktopEntryParser.hpp"
+#include "FuzzyMatch.hpp"
+#include "SearchKey.hpp"
+#include "SubstringScan.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <unordered_set>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+AppDatabase::AppDatabase() : AppDatabase(LoadOptions{}) {
+}
+
+AppDatabase::AppDatabase(const LoadOptions& options) : m_options(options) {
+    if (m_options.trackUsage) {
+        m_usage.open(m_options.usagePath.empty() ? UsageStore::defaultPath() : m_options.usagePath);
+    }
+    if (m_options.checkTryExec) {
+        m_pathIndex.build();
+        if (m_options.watch) {
+            m_pathIndex.watch();
+        }
+    }
+    loadApps();
+}
+
+AppDatabase::~AppDatabase() {
+    if (m_watchFd >= 0) {
+        ::close(m_watchFd);
+    }
+}
+
+namespace {
+
+// Whether any entry of a ';'-separated desktop list names a current desktop
+bool matchesDesktop(std::string_view list, const std::vector<std::string>& desktops) {
+    while (!list.empty()) {
+        size_t sep = list.find(';');
+        std::string_view name = list.substr(0, sep);
+        list = sep == std::string_view::npos ? std::string_view{} : list.substr(sep + 1);
+
+        if (!name.empty() && std::find(desktops.begin(), desktops.end(), name) != desktops.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> currentDesktops() {
+    std::vector<std::string> desktops;
+    const char* env = std::getenv("XDG_CURRENT_DESKTOP");
+    std::string_view list = env ? env : "";
+
+    while (!list.empty()) {
+        size_t sep = list.find(':');
+        if (sep > 0) desktops.emplace_back(list.substr(0, sep));
+        list = sep == std::string_view::npos ? std::string_view{} : list.substr(sep + 1);
+    }
+
+    // The launcher is written for Hyprland; assume it when the session is silent
+    if (desktops.empty()) desktops.emplace_back("Hyprland");
+    return desktops;
+}
+
+// Items tested between two looks at the cancel token
+constexpr size_t CANCEL_CHECK_INTERVAL = 512;
+
+// Strip AppDatabase::EXACT_PREFIX from `query`; returns whether it was there
+bool takeExactPrefix(std::string_view& query) {
+    if (query.empty() || query.front() != AppDatabase::EXACT_PREFIX) return false;
+    query.remove_prefix(1);
+    return true;
+}
+
+// Position of the first occurrence of `pattern` in `key` that starts a
+// word, or npos
+size_t findWordStart(std::string_view key, std::string_view pattern) {
+    for (size_t pos = key.find(pattern); pos != std::string_view::npos; pos = key.find(pattern, pos + 1)) {
+        if (SearchFields::startsWord(key, pos)) return pos;
+    }
+    return std::string_view::npos;
+}
+
+// Masks of a query key: its FuzzyMatch mask, and the word-start bit of its
+// first two bytes (none for a single byte, which every mask passes)
+struct QueryMasks {
+    explicit QueryMasks(std::string_view queryKey)
+        : all(FuzzyMatch::charMask(queryKey)),
+          wordStart(queryKey.size() >= 2 ? SearchFields::wordStartBit(queryKey, 0) : 0) {}
+
+    uint64_t all;
+    uint64_t wordStart;
+};
+
+// Whether one field of `id` can match by its masks alone: it holds every
+// byte class of the query and, if searched by WORD_PREFIX, a word that
+// could start like the query
+bool fieldMayMatch(const AppStore& store, AppStore::AppId id, const SearchFields::FieldInfo& info,
+                   const QueryMasks& masks) {
+    if (!FuzzyMatch::mayMatch(store.fieldMask(id, info.field), masks.all)) return false;
+    return info.mode != SearchFields::MatchMode::WORD_PREFIX ||
+           FuzzyMatch::mayMatch(store.wordStartMask(id), masks.wordStart);
+}
+
+// Whether `queryKey` matches at least one field of `id`, each tested the
+// way SearchFields::TABLE says
+bool matchesAnyField(const AppStore& store, AppStore::AppId id, std::string_view queryKey, const QueryMasks& masks) {
+    for (const auto& info : SearchFields::TABLE) {
+        if (!fieldMayMatch(store, id, info, masks)) continue;
+
+        const std::string_view key = store.fieldKey(id, info.field);
+        if (info.mode == SearchFields::MatchMode::FUZZY ? FuzzyMatch::matches(key, queryKey)
+                                                         : findWordStart(key, queryKey) != std::string_view::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Best score of `queryKey` over the fields of `id`, each adjusted by its
+// bias, or NO_MATCH. No alignment scores above `ceiling`, so fields whose
+// bias keeps them below the best so far are skipped.
+int scoreFields(const AppStore& store, AppStore::AppId id, std::string_view queryKey, const QueryMasks& masks,
+                int ceiling) {
+    int best = FuzzyMatch::NO_MATCH;
+    for (const auto& info : SearchFields::TABLE) {
+        if (best != FuzzyMatch::NO_MATCH && ceiling + info.bias <= best) continue;
+        if (!fieldMayMatch(store, id, info, masks)) continue;
+
+        const std::string_view key = store.fieldKey(id, info.field);
+
+        int score;
+        if (info.mode == SearchFields::MatchMode::FUZZY) {
+            // Only the name is kept as text for the camelCase bonus
+            score = FuzzyMatch::score(key, queryKey, info.field == SearchField::NAME ? store.name(id) : "");
+        } else {
+            // A word-start run scores like a prefix of the word
+            const size_t pos = findWordStart(key, queryKey);
+            score = pos == std::string_view::npos ? FuzzyMatch::NO_MATCH
+                                                  : FuzzyMatch::score(key.substr(pos, queryKey.size()), queryKey);
+        }
+
+        if (score != FuzzyMatch::NO_MATCH) best = std::max(best, score + info.bias);
+    }
+    return best;
+}
+
+// Rank points per doubling of an app's frecency: one recent launch is
+// worth a few points, a daily habit about as much as a word-boundary bonus
+// on every matched character, so history breaks near-ties without lifting
+// a poor match over a good one
+constexpr double FRECENCY_WEIGHT = 4;
+
+// Mark in `hits`, indexed by AppId, how many query words the word index
+// found for each app, and return how many words the query has. A lone
+// word may start any word of a name or its initials; several words must
+// each start a word of the same name, so only those count. Returns 0 if
+// the query has no words (or too many to count).
+size_t markIndexHits(const PrefixTrie& index, std::string_view queryKey, std::vector<uint8_t>& hits) {
+    thread_local std::vector<std::string_view> words;
+    words.clear();
+    for (size_t pos = 0; pos < queryKey.size();) {
+        if (!SearchFields::isWordByte(static_cast<unsigned char>(queryKey[pos]))) {
+            ++pos;
+            continue;
+        }
+        size_t end = pos;
+        while (end < queryKey.size() && SearchFields::isWordByte(static_cast<unsigned char>(queryKey[end]))) ++end;
+        words.push_back(queryKey.substr(pos, end - pos));
+        pos = end;
+    }
+    if (words.empty() || words.size() > UINT8_MAX) return 0;
+
+    // An app counts word k only once it has words 0..k-1, so its count
+    // reaches words.size() only if every word hit
+    for (size_t k = 0; k < words.size(); ++k) {
+        for (const auto& entry : index.find(words[k])) {
+            if (words.size() > 1 && entry.tag != static_cast<uint8_t>(NameTerm::WORD)) continue;
+            if (hits[entry.id] == k) hits[entry.id] = static_cast<uint8_t>(k + 1);
+        }
+    }
+    return words.size();
+}
+
+struct RankedApp {
+    // Found by the word index
+    bool indexed = false;
+    int score = 0;
+    uint32_t keyLength = 0;
+    // Index into the matches being ranked, which are in display order
+    uint32_t position = 0;
+};
+
+} // namespace
+
+void AppDatabase::queryKey(std::string_view query, std::string& key) {
+    const bool exact = takeExactPrefix(query);
+    SearchKey::assign(query, key);
+    if (exact) key.insert(key.begin(), EXACT_PREFIX);
+}
+
+void AppDatabase::filterApps(std::string_view query, std::vector<AppStore::AppId>& out,
+                             const CancelToken& cancel) const {
+    const auto& sorted = m_store.sorted();
+
+    if (query.empty()) {
+        out.assign(sorted.begin(), sorted.end());
+        return;
+    }
+
+    // Reused across calls so a warmed-up search does not allocate
+    thread_local std::string queryKey;
+    const bool exact = takeExactPrefix(query);
+    SearchKey::assign(query, queryKey);
+
+    out.clear();
+    if (exact) {
+        m_store.sortedKeys().forEachMatch(queryKey, [&](size_t index) {
+            out.push_back(sorted[index]);
+        });
+        return;
+    }
+
+    // The mask tests reject most apps before their keys are touched
+    const QueryMasks masks(queryKey);
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        if (i % CANCEL_CHECK_INTERVAL == 0 && cancel.cancelled()) return;
+
+        const AppStore::AppId id = sorted[i];
+        if (FuzzyMatch::mayMatch(m_store.searchMask(id), masks.all) && matchesAnyField(m_store, id, queryKey, masks)) {
+            out.push_back(id);
+        }
+    }
+}
+
+void AppDatabase::refineApps(std::string_view query, std::span<const AppStore::AppId> candidates,
+                             std::vector<AppStore::AppId>& out, const CancelToken& cancel) const {
+    if (query.empty()) {
+        out.assign(candidates.begin(), candidates.end());
+        return;
+    }
+
+    thread_local std::string queryKey;
+    const bool exact = takeExactPrefix(query);
+    SearchKey::assign(query, queryKey);
+
+    // Candidates are scattered through the packed keys, so test them one by one
+    out.clear();
+    if (exact) {
+        for (AppStore::AppId id : candidates) {
+            if (SubstringScan::contains(m_store.searchKeys(id), queryKey)) {
+                out.push_back(id);
+            }
+        }
+        return;
+    }
+
+    const QueryMasks masks(queryKey);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (i % CANCEL_CHECK_INTERVAL == 0 && cancel.cancelled()) return;
+
+        const AppStore::AppId id = candidates[i];
+        if (FuzzyMatch::mayMatch(m_store.searchMask(id), masks.all) && matchesAnyField(m_store, id, queryKey, masks)) {
+            out.push_back(id);
+        }
+    }
+}
+
+void AppDatabase::rankApps(std::string_view query, std::span<const AppStore::AppId> matches, size_t limit,
+                           std::vector<AppStore::AppId>& out, const CancelToken& cancel) const {
+    thread_local std::string queryKey;
+    takeExactPrefix(query);
+    SearchKey::assign(query, queryKey);
+
+    // With no query there is nothing to score but the history; without
+    // one either, display order stands
+    const std::vector<int>& bonuses = usageBonuses();
+    const bool byUsage = queryKey.empty();
+    if (byUsage && bonuses.empty()) {
+        out.assign(matches.begin(), matches.end());
+        return;
+    }
+
+    thread_local std::vector<uint8_t> hits;
+    hits.assign(byUsage ? 0 : m_store.idLimit(), 0);
+    const size_t queryWords = byUsage ? 0 : markIndexHits(m_store.wordIndex(), queryKey, hits);
+
+    const QueryMasks masks(queryKey);
+    const int ceiling = FuzzyMatch::maxScore(queryKey.size());
+    thread_local std::vector<RankedApp> ranked;
+    ranked.clear();
+    for (size_t i = 0; i < matches.size(); ++i) {
+        if (i % CANCEL_CHECK_INTERVAL == 0 && cancel.cancelled()) return;
+
+        const AppStore::AppId id = matches[i];
+        if (byUsage) {
+            ranked.push_back({false, bonuses[id], 0, static_cast<uint32_t>(i)});
+            continue;
+        }
+
+        const std::string_view key = m_store.nameKey(id);
+        int score = scoreFields(m_store, id, queryKey, masks, ceiling);
+        if (!bonuses.empty()) score += bonuses[id];
+        const bool indexed = queryWords > 0 && hits[id] == queryWords;
+        ranked.push_back({indexed, score, static_cast<uint32_t>(key.size()), static_cast<uint32_t>(i)});
+    }
+
+    const size_t top = std::min(limit, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<ptrdiff_t>(top), ranked.end(),
+                      [](const RankedApp& a, const RankedApp& b) {
+                          if (a.indexed != b.indexed) return a.indexed;
+                          if (a.score != b.score) return a.score > b.score;
+                          if (a.keyLength != b.keyLength) return a.keyLength < b.keyLength;
+                          return a.position < b.position;
+                      });
+
+    // The ranked page, then everything else where it was
+    thread_local std::vector<uint8_t> taken;
+    taken.assign(matches.size(), 0);
+    out.clear();
+    for (size_t i = 0; i < top; ++i) {
+        out.push_back(matches[ranked[i].position]);
+        taken[ranked[i].position] = 1;
+    }
+    for (size_t i = 0; i < matches.size(); ++i) {
+        if (!taken[i]) out.push_back(matches[i]);
+    }
+}
+
+void AppDatabase::recordLaunch(AppStore::AppId id) {
+    if (!m_options.trackUsage || !m_store.contains(id)) return;
+
+    if (m_usage.recordLaunch(m_store.desktopId(id), UsageStore::now())) {
+        m_usageBonusesValid = false;
+        ++m_usageVersion;
+    }
+}
+
+const std::vector<int>& AppDatabase::usageBonuses() const {
+    if (m_usageBonusesValid && m_usageBonusGeneration == m_generation) return m_usageBonuses;
+
+    m_usageBonuses.clear();
+    if (m_usage.size() > 0) {
+        const int64_t now = UsageStore::now();
+        m_usageBonuses.assign(m_store.idLimit(), 0);
+        for (AppStore::AppId id : m_store.sorted()) {
+            const double frecency = m_usage.frecency(m_store.desktopId(id), now);
+            if (frecency > 0) {
+                m_usageBonuses[id] = static_cast<int>(std::lround(FRECENCY_WEIGHT * std::log2(1 + frecency)));
+            }
+        }
+    }
+
+    m_usageBonusGeneration = m_generation;
+    m_usageBonusesValid = true;
+    return m_usageBonuses;
+}
+
+std::vector<fs::path> AppDatabase::searchPath() {
+    std::vector<fs::path> dirs;
+
+    const char* dataHome = std::getenv("XDG_DATA_HOME");
+    const char* home = std::getenv("HOME");
+    if (dataHome && dataHome[0] == '/') {
+        dirs.push_back(fs::path(dataHome) / "applications");
+    } else if (home) {
+        dirs.push_back(fs::path(home) / ".local/share/applications");
+    }
+
+    const char* dataDirs = std::getenv("XDG_DATA_DIRS");
+    std::string_view list = dataDirs && dataDirs[0] ? dataDirs : "/usr/local/share:/usr/share";
+
+    while (!list.empty()) {
+        size_t sep = list.find(':');
+        std::string_view entry = list.substr(0, sep);
+        list = sep == std::string_view::npos ? std::string_view{} : list.substr(sep + 1);
+
+        // The spec only allows absolute paths; relative ones are ignored
+        if (entry.empty() || entry.front() != '/') continue;
+
+        fs::path dir = (fs::path(entry) / "applications").lexically_normal();
+        if (std::find(dirs.begin(), dirs.end(), dir) == dirs.end()) {
+            dirs.push_back(std::move(dir));
+        }
+    }
+
+    return dirs;
+}
+
+bool AppDatabase::isListed(const DesktopApp& app) const {
+    if (!app.isVisible()) return false;
+    if (m_options.checkTryExec && !app.tryExec.empty() && !m_pathIndex.canExecute(app.tryExec)) {
+        return false;
+    }
+    if (!app.onlyShowIn.empty() && !matchesDesktop(app.onlyShowIn, m_desktops)) return false;
+    if (!app.notShowIn.empty() && matchesDesktop(app.notShowIn, m_desktops)) return false;
+    return true;
+}
+
+size_t AppDatabase::loadApps() {
+    auto start = std::chrono::steady_clock::now();
+
+    m_searchDirs.clear();
+    m_parsedCount = m_cachedCount = m_shadowedCount = 0;
+
+    m_desktops = m_options.desktops.empty() ? currentDesktops() : m_options.desktops;
+
+    std::vector<fs::path> desktopDirs = m_options.directories;
+    if (desktopDirs.empty()) {
+        desktopDirs = searchPath();
+    }
+
+    m_indexPath = m_options.indexPath.empty() ? AppIndexCache::defaultPath()
+                                              : m_options.indexPath;
+    AppIndexCache cache;
+    if (!m_options.useIndex || !cache.open(m_indexPath)) {
+        m_indexDirty = true;
+    }
+
+    // Pass 1: walk directories in precedence order and reuse every record the
+    // index still vouches for
+    std::vector<AppIndexDirectory> indexDirs;
+    std::vector<ParseJob> jobs;
+    for (const auto& dir : desktopDirs) {
+        if (fs::is_directory(dir)) {
+            scanDirectory(dir, "", cache, indexDirs, jobs);
+        }
+    }
+
+    if (m_options.watch) {
+        setupWatches();
+    }
+
+    // A directory that disappeared since the last run also invalidates the index
+    if (indexDirs.size() != cache.directoryCount()) {
+        m_indexDirty = true;
+    }
+
+    // Pass 2: parse whatever changed across the worker pool
+    parseJobs(jobs, indexDirs);
+
+    // Pass 3: the first directory to provide an ID owns it. An owner that is
+    // Hidden or not meant for this desktop still masks every later copy.
+    std::vector<DesktopApp> listed;
+    std::unordered_set<std::string_view> seenIds;
+    seenIds.reserve(m_cachedCount + m_parsedCount);
+    for (auto& indexDir : indexDirs) {
+        for (auto& record : indexDir.records) {
+            if (record.isDirectory) continue;
+
+            record.app.id = indexDir.idPrefix + record.fileName;
+            if (!seenIds.insert(record.app.id).second) {
+                ++m_shadowedCount;
+                continue;
+            }
+            if (isListed(record.app)) {
+                listed.push_back(record.app);
+            }
+        }
+    }
+
+    size_t changed = m_store.assign(listed);
+
+    // The index only holds complete records, so with lazy details it is
+    // written once loadDetails() has caught up
+    queueDetailJobs(std::move(indexDirs));
+
+    if (m_options.verbose) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        std::cout << "AppDatabase: " << m_store.size() << " apps (" << m_cachedCount
+                  << " from index, " << m_parsedCount << " parsed, " << m_shadowedCount
+                  << " shadowed) in " << elapsed.count() / 1000.0 << " ms";
+        if (pendingDetails() > 0) {
+            std::cout << ", details pending for " << pendingDetails();
+        }
+        std::cout << std::endl;
+        for (const auto& dir : m_searchDirs) {
+            std::cout << "  " << dir.path.string() << ": " << dir.files << " files ("
+                      << dir.cached << " from index, " << dir.parsed << " parsed), listed in "
+                      << dir.scanMs << " ms" << std::endl;
+        }
+    }
+
+    return changed;
+}
+
+void AppDatabase::scanDirectory(const fs::path& directory, const std::string& idPrefix,
+                                const AppIndexCache& cache,
+                                std::vector<AppIndexDirectory>& indexDirs,
+                                std::vector<ParseJob>& jobs) {
+    auto start = std::chrono::steady_clock::now();
+
+    // indexDirs grows while recursing, so refer to this directory by index
+    const size_t dirIndex = indexDirs.size();
+    {
+        auto& indexDir = indexDirs.emplace_back();
+        indexDir.path = directory.string();
+        indexDir.idPrefix = idPrefix;
+
+        uint64_t dirSize = 0;
+        if (!statFile(directory, indexDir.mtime, dirSize)) {
+            indexDirs.pop_back();
+            return;
+        }
+    }
+    m_searchDirs.push_back({directory, idPrefix});
+
+    auto& indexDir = indexDirs[dirIndex];
+    auto& stats = m_searchDirs.back();
+
+    const auto* cachedDir = cache.findDirectory(indexDir.path);
+    if (!cachedDir || cachedDir->mtime != indexDir.mtime) {
+        m_indexDirty = true;
+    }
+
+    auto addFile = [&](const std::string& fileName) {
+        fs::path filepath = directory / fileName;
+
+        AppIndexRecord record;
+        record.fileName = fileName;
+        if (!statFile(filepath, record.mtime, record.size)) {
+            m_indexDirty = true;
+            return;
+        }
+
+        const auto* cached = cachedDir ? cachedDir->find(fileName) : nullptr;
+        if (cached && cached->mtime == record.mtime && cached->size == record.size) {
+            record.app = cached->toApp(directory);
+            ++m_cachedCount;
+            ++stats.cached;
+        } else {
+            jobs.push_back({std::move(filepath), dirIndex, indexDir.records.size()});
+            m_indexDirty = true;
+        }
+
+        ++stats.files;
+        indexDir.records.push_back(std::move(record));
+    };
+
+    std::vector<std::string> subdirs;
+
+    // An unchanged directory mtime means no entries were added or removed, so
+    // the cached file list can stand in for the directory listing
+    if (cachedDir && cachedDir->mtime == indexDir.mtime) {
+        for (const auto& entry : cachedDir->entries) {
+            if (entry.isDirectory()) {
+                subdirs.emplace_back(entry.fileName);
+            } else {
+                addFile(std::string(entry.fileName));
+            }
+        }
+    } else {
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(directory, ec)) {
+            // Symlinked directories are skipped so a link loop cannot recurse forever
+            if (entry.is_directory(ec) && !entry.is_symlink(ec)) {
+                subdirs.push_back(entry.path().filename().string());
+            } else if (entry.path().extension() == ".desktop") {
+                addFile(entry.path().filename().string());
+            }
+        }
+    }
+
+    for (const auto& subdir : subdirs) {
+        AppIndexRecord record;
+        record.fileName = subdir;
+        record.isDirectory = true;
+        indexDir.records.push_back(std::move(record));
+    }
+
+    stats.scanMs = std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - start).count();
+
+    // Recurse last: `indexDir` and `stats` are invalidated from here on
+    for (const auto& subdir : subdirs) {
+        scanDirectory(directory / subdir, idPrefix + subdir + "-", cache, indexDirs, jobs);
+    }
+}
+
+void AppDatabase::parseJobs(const std::vector<ParseJob>& jobs,
+                            std::vector<AppIndexDirectory>& indexDirs) {
+    if (jobs.empty()) return;
+
+    // Small batches are not worth waking threads for
+    constexpr size_t GRAIN = 32;
+    WorkerPool pool(m_options.workerCount);
+
+    // Each worker appends to its own vector; results are merged by job index
+    // afterwards so the outcome is identical to parsing serially
+    std::vector<std::vector<std::pair<size_t, std::optional<DesktopApp>>>> perWorker(
+        pool.workersFor(jobs.size(), GRAIN));
+
+    pool.forEach(jobs.size(), GRAIN, [&](size_t worker, size_t index) {
+        const auto& path = jobs[index].path;
+        perWorker[worker].emplace_back(index, m_options.lazyDetails
+                                                  ? DesktopEntryParser::parseListFields(path)
+                                                  : DesktopEntryParser::parseFile(path));
+    });
+
+    std::vector<bool> failed(jobs.size(), false);
+    for (auto& results : perWorker) {
+        for (auto& [index, app] : results) {
+            const auto& job = jobs[index];
+            if (app) {
+                indexDirs[job.dirIndex].records[job.recordIndex].app = std::move(*app);
+                ++m_searchDirs[job.dirIndex].parsed;
+                ++m_parsedCount;
+            } else {
+                failed[index] = true;
+            }
+        }
+    }
+
+    // Drop records for files that vanished or could not be read; walking the
+    // jobs backwards keeps the remaining record indices valid while erasing
+    for (size_t i = jobs.size(); i-- > 0;) {
+        if (failed[i]) {
+            auto& records = indexDirs[jobs[i].dirIndex].records;
+            records.erase(records.begin() + jobs[i].recordIndex);
+            --m_searchDirs[jobs[i].dirIndex].files;
+        }
+    }
+}
+
+void AppDatabase::queueDetailJobs(std::vector<AppIndexDirectory>&& indexDirs) {
+    m_detailJobs.clear();
+    m_nextDetailJob = 0;
+    m_detailMs = 0;
+
+    for (uint32_t d = 0; d < indexDirs.size(); ++d) {
+        const auto& records = indexDirs[d].records;
+        for (uint32_t r = 0; r < records.size(); ++r) {
+            if (!records[r].isDirectory && !records[r].app.detailsLoaded) {
+                m_detailJobs.emplace_back(d, r);
+            }
+        }
+    }
+
+    m_detailDirs = std::move(indexDirs);
+    loadDetails(0);
+}
+
+size_t AppDatabase::loadDetails(size_t maxEntries) {
+    auto start = std::chrono::steady_clock::now();
+
+    const size_t end = std::min(m_detailJobs.size(), m_nextDetailJob + maxEntries);
+    for (; m_nextDetailJob < end; ++m_nextDetailJob) {
+        const auto [dirIndex, recordIndex] = m_detailJobs[m_nextDetailJob];
+        auto& app = m_detailDirs[dirIndex].records[recordIndex].app;
+
+        // A vanished file leaves an incomplete record; its stat data no
+        // longer matches, so the next start parses it again anyway
+        if (!DesktopEntryParser::parseDetails(fs::path(app.desktopFile), app)) continue;
+
+        // Only the entry that won its ID is in the store
+        AppStore::AppId id = m_store.find(app.id);
+        if (id != AppStore::INVALID_ID && !m_store.hasDetails(id) &&
+            m_store.desktopFile(id) == app.desktopFile) {
+            m_store.setDetails(id, app);
+        }
+    }
+
+    m_detailMs += std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - start).count();
+
+    if (pendingDetails() > 0) return pendingDetails();
+
+    if (m_options.useIndex && m_indexDirty && !m_detailDirs.empty()) {
+        AppIndexCache::write(m_indexPath, m_detailDirs);
+        m_indexDirty = false;
+    }
+
+    if (m_options.verbose && !m_detailJobs.empty()) {
+        std::cout << "AppDatabase: details for " << m_detailJobs.size() << " entries in "
+                  << m_detailMs << " ms" << std::endl;
+    }
+
+    m_detailDirs.clear();
+    m_detailDirs.shrink_to_fit();
+    m_detailJobs.clear();
+    m_detailJobs.shrink_to_fit();
+    m_nextDetailJob = 0;
+    return 0;
+}
+
+void AppDatabase::ensureDetails(AppStore::AppId id) {
+    if (!m_store.contains(id) || m_store.hasDetails(id)) return;
+
+    DesktopApp app;
+    app.entryOffset = m_store.entryOffset(id);
+    if (DesktopEntryParser::parseDetails(fs::path(m_store.desktopFile(id)), app)) {
+        m_store.setDetails(id, app);
+    }
+}
+
+void AppDatabase::setupWatches() {
+    if (m_watchFd < 0) {
+        m_watchFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_watchFd < 0) {
+            std::cerr << "Warning: inotify unavailable, new apps need a restart" << std::endl;
+            return;
+        }
+    }
+
+    // Re-adding a watched directory returns its existing descriptor, so this
+    // is also how directories found by a rescan get picked up
+    constexpr uint32_t MASK = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+    m_watchedDirs.clear();
+    for (size_t i = 0; i < m_searchDirs.size(); ++i) {
+        int wd = ::inotify_add_watch(m_watchFd, m_searchDirs[i].path.c_str(), MASK | IN_ONLYDIR);
+        if (wd >= 0) {
+            m_watchedDirs[wd] = i;
+        }
+    }
+}
+
+bool AppDatabase::readWatchEvents() {
+    if (m_pathIndex.readWatchEvents()) {
+        m_pendingPathChange = true;
+    }
+    if (m_watchFd < 0) return m_pendingPathChange;
+
+    alignas(inotify_event) char buffer[4096];
+    for (;;) {
+        ssize_t len = ::read(m_watchFd, buffer, sizeof(buffer));
+        if (len <= 0) break;
+
+        for (ssize_t offset = 0; offset < len;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                m_pendingRescan = true;
+                continue;
+            }
+
+            auto dir = m_watchedDirs.find(event->wd);
+            if (dir == m_watchedDirs.end() || event->len == 0) continue;
+
+            // A subdirectory appearing or going away changes a whole ID range
+            if (event->mask & IN_ISDIR) {
+                m_pendingRescan = true;
+                continue;
+            }
+
+            std::string_view name = event->name;
+            if (name.ends_with(".desktop")) {
+                m_pendingIds.insert(m_searchDirs[dir->second].idPrefix + std::string(name));
+            }
+        }
+    }
+
+    return m_pendingRescan || m_pendingPathChange || !m_pendingIds.empty();
+}
+
+size_t AppDatabase::applyPendingChanges() {
+    size_t changed = 0;
+
+    // A program appearing or disappearing can flip any TryExec entry; the
+    // index makes re-resolving everything cheap
+    if (m_pendingPathChange && m_pathIndex.applyPendingChanges()) {
+        m_pendingRescan = true;
+    }
+    m_pendingPathChange = false;
+
+    if (m_pendingRescan) {
+        // The kernel dropped events, so nothing short of a full reload is safe
+        changed = loadApps();
+    } else {
+        for (const auto& id : m_pendingIds) {
+            changed += updateEntry(id);
+        }
+    }
+
+    m_pendingIds.clear();
+    m_pendingRescan = false;
+
+    if (changed > 0) {
+        ++m_generation;
+    }
+    return changed;
+}
+
+size_t AppDatabase::updateEntry(const std::string& id) {
+    // Re-resolve the ID across every directory: removing an override exposes
+    // the entry it shadowed, and adding one hides it again
+    std::optional<DesktopApp> app;
+    for (const auto& dir : m_searchDirs) {
+        if (!id.starts_with(dir.idPrefix)) continue;
+
+        fs::path filepath = dir.path / id.substr(dir.idPrefix.size());
+        if (!fs::exists(filepath)) continue;
+
+        app = DesktopEntryParser::parseFile(filepath);
+        if (app) {
+            app->id = id;
+            break;
+        }
+    }
+
+    if (app && isListed(*app)) {
+        return m_store.upsert(*app) ? 1 : 0;
+    }
+    return m_store.remove(id) ? 1 : 0;
+}
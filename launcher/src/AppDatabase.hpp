@@ -0,0 +1,204 @@
+#ifndef APP_DATABASE_HPP
+#define APP_DATABASE_HPP
+
+#include "AppIndexCache.hpp"
+#include "AppStore.hpp"
+#include "CancelToken.hpp"
+#include "DesktopApp.hpp"
+#include "PathIndex.hpp"
+#include "UsageStore.hpp"
+#include <cstdint>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+class AppDatabase {
+  public:
+    struct LoadOptions {
+        // Application directories in precedence order; empty means searchPath()
+        std::vector<fs::path> directories;
+        // Desktop names for OnlyShowIn/NotShowIn; empty means XDG_CURRENT_DESKTOP
+        std::vector<std::string> desktops;
+        // On-disk index location; empty means AppIndexCache::defaultPath()
+        fs::path indexPath;
+        bool useIndex = true;
+        // Launch history location; empty means UsageStore::defaultPath()
+        fs::path usagePath;
+        // Rank by launch history and record launches
+        bool trackUsage = true;
+        // Parser threads; 0 means one per hardware thread
+        size_t workerCount = 0;
+        // Parse only what the list shows up front and leave the rest to
+        // loadDetails(). Off by default: the list fields can sit anywhere in
+        // a file, so the first pass reads every file whole anyway and the
+        // detail pass reads them again.
+        bool lazyDetails = false;
+        // Hide entries whose TryExec program is missing
+        bool checkTryExec = true;
+        // Watch the directories with inotify so installs show up live
+        bool watch = true;
+        bool verbose = true;
+    };
+
+    // One scanned directory, subdirectories included, in precedence order
+    struct SearchDirectory {
+        fs::path path;
+        // Prepended to file names to form desktop-file IDs ("kde4-" for kde4/)
+        std::string idPrefix;
+        size_t files = 0;
+        size_t cached = 0;
+        size_t parsed = 0;
+        double scanMs = 0;
+    };
+
+    AppDatabase();
+    explicit AppDatabase(const LoadOptions& options);
+    ~AppDatabase();
+
+    AppDatabase(const AppDatabase&) = delete;
+    AppDatabase& operator=(const AppDatabase&) = delete;
+
+    // $XDG_DATA_HOME/applications followed by $XDG_DATA_DIRS/applications
+    static std::vector<fs::path> searchPath();
+
+    const AppStore& apps() const { return m_store; }
+    const std::vector<SearchDirectory>& searchDirectories() const { return m_searchDirs; }
+
+    // Queries starting with this match as plain substrings instead of fuzzily
+    static constexpr char EXACT_PREFIX = '\'';
+
+    // Fill `key` with what decides the answer to `query`: the exact prefix,
+    // if any, and the SearchKey of the rest. Queries with the same key get
+    // the same results from filterApps() and rankApps().
+    static void queryKey(std::string_view query, std::string& key);
+
+    // Fill `out` with the IDs of the apps that have a SearchField matching
+    // `query` (see FuzzyMatch), compared by SearchKey (ignoring case and
+    // accents), in display order. `out` is cleared first and its capacity
+    // reused, so a warmed-up buffer never allocates. Once `cancel` fires,
+    // this returns with `out` incomplete.
+    void filterApps(std::string_view query, std::vector<AppStore::AppId>& out,
+                    const CancelToken& cancel = {}) const;
+
+    // Same test over `candidates` only, keeping their order. Used to narrow
+    // an earlier result set; `out` must not alias `candidates`.
+    void refineApps(std::string_view query, std::span<const AppStore::AppId> candidates,
+                    std::vector<AppStore::AppId>& out, const CancelToken& cancel = {}) const;
+
+    // Order `matches` (in display order, as filterApps() returns them) for
+    // showing: the best `limit` first, then the rest in display order.
+    // Apps the word index finds come before all others: names with a word
+    // or initials starting with the query, or, for several query words, a
+    // word starting with each. Within that, apps go by the score of their
+    // best field (see SearchFields::TABLE) plus a frecency bonus, ties
+    // going to the shorter name. An empty query ranks by
+    // frecency alone. Only that first page is sorted, so long result lists
+    // cost one score per field each and no full sort.
+    void rankApps(std::string_view query, std::span<const AppStore::AppId> matches, size_t limit,
+                  std::vector<AppStore::AppId>& out, const CancelToken& cancel = {}) const;
+
+    // Count a launch of `id` toward its frecency (see UsageStore)
+    void recordLaunch(AppStore::AppId id);
+    // Bumped by every recorded launch, which can change how results rank
+    uint64_t usageVersion() const { return m_usageVersion; }
+
+    // Parse deferred details for up to `maxEntries` entries. Once nothing is
+    // left the index is written. Returns the number of entries still pending.
+    size_t loadDetails(size_t maxEntries);
+    // Parse every deferred detail, so the index is written before exit
+    void finishDetails() { loadDetails(SIZE_MAX); }
+    size_t pendingDetails() const { return m_detailJobs.size() - m_nextDetailJob; }
+
+    // Make exec and categories of one app available right away
+    void ensureDetails(AppStore::AppId id);
+
+    // Bumped every time the app list changes after the initial load
+    uint64_t generation() const { return m_generation; }
+
+    // Executables on $PATH, used for TryExec and the launcher's command mode
+    const PathIndex& pathIndex() const { return m_pathIndex; }
+
+    // inotify descriptors to register with the event loop, or -1. Both are
+    // drained by readWatchEvents().
+    int watchFd() const { return m_watchFd; }
+    int pathWatchFd() const { return m_pathIndex.watchFd(); }
+
+    // Drain queued inotify events. Returns true if changes are pending; they
+    // are kept until applyPendingChanges() so bursts can be coalesced.
+    bool readWatchEvents();
+
+    // Apply pending changes as single-entry updates to the sorted list.
+    // Returns the number of entries added, replaced or removed.
+    size_t applyPendingChanges();
+
+  private:
+    // A file whose index record is missing or stale and must be parsed
+    struct ParseJob {
+        fs::path path;
+        size_t dirIndex = 0;
+        size_t recordIndex = 0;
+    };
+
+    // Returns the number of entries added, replaced or removed
+    size_t loadApps();
+    void scanDirectory(const fs::path& directory, const std::string& idPrefix,
+                       const AppIndexCache& cache, std::vector<AppIndexDirectory>& indexDirs,
+                       std::vector<ParseJob>& jobs);
+    void parseJobs(const std::vector<ParseJob>& jobs, std::vector<AppIndexDirectory>& indexDirs);
+    void queueDetailJobs(std::vector<AppIndexDirectory>&& indexDirs);
+    void setupWatches();
+    size_t updateEntry(const std::string& id);
+
+    // Visible, runnable per TryExec, and allowed on the current desktop by
+    // OnlyShowIn/NotShowIn
+    bool isListed(const DesktopApp& app) const;
+
+    // Rank bonus per AppId from the launch history, or empty if there is
+    // none. Rebuilt when the app list changes or a launch is recorded.
+    const std::vector<int>& usageBonuses() const;
+
+    LoadOptions m_options;
+    std::vector<std::string> m_desktops;
+    std::vector<SearchDirectory> m_searchDirs;
+    AppStore m_store;
+    PathIndex m_pathIndex;
+    uint64_t m_generation = 0;
+
+    UsageStore m_usage;
+    uint64_t m_usageVersion = 0;
+    mutable std::vector<int> m_usageBonuses;
+    mutable uint64_t m_usageBonusGeneration = 0;
+    mutable bool m_usageBonusesValid = false;
+
+    int m_watchFd = -1;
+    // Watch descriptor -> index into m_searchDirs
+    std::unordered_map<int, size_t> m_watchedDirs;
+    std::set<std::string> m_pendingIds;
+    bool m_pendingRescan = false;
+    bool m_pendingPathChange = false;
+
+    // Load statistics, reported once after startup
+    size_t m_parsedCount = 0;
+    size_t m_cachedCount = 0;
+    size_t m_shadowedCount = 0;
+
+    // Set when the on-disk index no longer matches what was loaded
+    bool m_indexDirty = false;
+    fs::path m_indexPath;
+
+    // Index records kept from loadApps() until their details are parsed.
+    // Jobs are (directory, record) indices; the path is built when run.
+    std::vector<AppIndexDirectory> m_detailDirs;
+    std::vector<std::pair<uint32_t, uint32_t>> m_detailJobs;
+    size_t m_nextDetailJob = 0;
+    double m_detailMs = 0;
+};
+
+#endif // APP_DATABASE_HPP
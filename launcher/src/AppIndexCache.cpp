@@ -0,0 +1,304 @@
+#include "AppIndexCache.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char MAGIC[8] = {'L', 'A', 'U', 'N', 'C', 'H', 'I', 'X'};
+
+// magic + version + directory count + payload size + payload checksum
+constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 4 + 4 + 8 + 8;
+
+enum EntryFlags : uint8_t {
+    FLAG_NO_DISPLAY = 1 << 0,
+    FLAG_HIDDEN = 1 << 1,
+    FLAG_DIRECTORY = 1 << 2,
+};
+
+// fileName + mtime + size + flags + entry offset + ten empty strings
+constexpr size_t MIN_RECORD_SIZE = 4 + 8 + 8 + 1 + 4 + 10 * 4;
+
+// Empty path + mtime + entry count
+constexpr size_t MIN_DIR_RECORD_SIZE = 4 + 8 + 4;
+
+uint64_t fnv1a(const char* data, size_t size) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Bounds-checked little reader over the mapped payload
+class Reader {
+  public:
+    Reader(const char* data, size_t size) : m_data(data), m_size(size) {}
+
+    template <typename T>
+    bool read(T& out) {
+        if (m_size - m_pos < sizeof(T)) return false;
+        std::memcpy(&out, m_data + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool readString(std::string_view& out) {
+        uint32_t len = 0;
+        if (!read(len) || m_size - m_pos < len) return false;
+        out = std::string_view(m_data + m_pos, len);
+        m_pos += len;
+        return true;
+    }
+
+    bool atEnd() const { return m_pos == m_size; }
+
+  private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+};
+
+template <typename T>
+void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendString(std::string& out, std::string_view str) {
+    append<uint32_t>(out, static_cast<uint32_t>(str.size()));
+    out.append(str);
+}
+
+} // namespace
+
+bool statFile(const fs::path& path, int64_t& mtime, uint64_t& size) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) return false;
+    mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+    size = static_cast<uint64_t>(st.st_size);
+    return true;
+}
+
+bool AppIndexCache::CachedEntry::isDirectory() const {
+    return (flags & FLAG_DIRECTORY) != 0;
+}
+
+DesktopApp AppIndexCache::CachedEntry::toApp(const fs::path& directory) const {
+    DesktopApp app;
+    app.name = std::string(name);
+    app.genericName = std::string(genericName);
+    app.keywords = std::string(keywords);
+    app.comment = std::string(comment);
+    app.exec = std::string(exec);
+    app.hasExec = !exec.empty();
+    app.entryOffset = entryOffset;
+    app.icon = std::string(icon);
+    app.desktopFile = (directory / fileName).string();
+    app.onlyShowIn = std::string(onlyShowIn);
+    app.notShowIn = std::string(notShowIn);
+    app.categories = std::string(categories);
+    app.tryExec = std::string(tryExec);
+    app.noDisplay = (flags & FLAG_NO_DISPLAY) != 0;
+    app.hidden = (flags & FLAG_HIDDEN) != 0;
+    return app;
+}
+
+const AppIndexCache::CachedEntry* AppIndexCache::CachedDirectory::find(std::string_view fileName) const {
+    auto it = byFileName.find(fileName);
+    return it == byFileName.end() ? nullptr : &entries[it->second];
+}
+
+AppIndexCache::~AppIndexCache() {
+    unmap();
+}
+
+fs::path AppIndexCache::defaultPath() {
+    const char* cacheHome = std::getenv("XDG_CACHE_HOME");
+    if (cacheHome && cacheHome[0] == '/') {
+        return fs::path(cacheHome) / "launcher" / "app-index.bin";
+    }
+
+    const char* home = std::getenv("HOME");
+    if (!home) return {};
+    return fs::path(home) / ".cache" / "launcher" / "app-index.bin";
+}
+
+bool AppIndexCache::open(const fs::path& path) {
+    unmap();
+    if (path.empty()) return false;
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER_SIZE) {
+        ::close(fd);
+        return false;
+    }
+
+    void* map = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) return false;
+
+    m_data = static_cast<const char*>(map);
+    m_size = static_cast<size_t>(st.st_size);
+
+    if (!parse()) {
+        std::cerr << "Warning: Ignoring stale or corrupt app index at " << path << "\n";
+        unmap();
+        return false;
+    }
+
+    m_valid = true;
+    return true;
+}
+
+bool AppIndexCache::parse() {
+    if (std::memcmp(m_data, MAGIC, sizeof(MAGIC)) != 0) return false;
+
+    Reader header(m_data + sizeof(MAGIC), HEADER_SIZE - sizeof(MAGIC));
+    uint32_t version = 0, dirCount = 0;
+    uint64_t payloadSize = 0, checksum = 0;
+    header.read(version);
+    header.read(dirCount);
+    header.read(payloadSize);
+    header.read(checksum);
+
+    if (version != VERSION || payloadSize != m_size - HEADER_SIZE) return false;
+
+    const char* payload = m_data + HEADER_SIZE;
+    if (fnv1a(payload, payloadSize) != checksum) return false;
+
+    // The header is not covered by the checksum, so its count must be
+    // checked against what the payload can hold before it sizes anything
+    if (dirCount > payloadSize / MIN_DIR_RECORD_SIZE) return false;
+
+    Reader reader(payload, payloadSize);
+    m_directories.resize(dirCount);
+
+    for (auto& dir : m_directories) {
+        uint32_t entryCount = 0;
+        if (!reader.readString(dir.path) || !reader.read(dir.mtime) || !reader.read(entryCount)) {
+            return false;
+        }
+
+        // Reject counts the payload cannot possibly hold
+        if (entryCount > payloadSize / MIN_RECORD_SIZE) return false;
+
+        dir.entries.resize(entryCount);
+        dir.byFileName.reserve(entryCount);
+
+        for (size_t i = 0; i < entryCount; ++i) {
+            auto& entry = dir.entries[i];
+            if (!reader.readString(entry.fileName) || !reader.read(entry.mtime) ||
+                !reader.read(entry.size) || !reader.read(entry.flags) ||
+                !reader.read(entry.entryOffset) ||
+                !reader.readString(entry.name) || !reader.readString(entry.genericName) ||
+                !reader.readString(entry.keywords) || !reader.readString(entry.comment) ||
+                !reader.readString(entry.exec) ||
+                !reader.readString(entry.icon) || !reader.readString(entry.onlyShowIn) ||
+                !reader.readString(entry.notShowIn) || !reader.readString(entry.categories) ||
+                !reader.readString(entry.tryExec)) {
+                return false;
+            }
+            dir.byFileName.emplace(entry.fileName, i);
+        }
+    }
+
+    return reader.atEnd();
+}
+
+void AppIndexCache::unmap() {
+    if (m_data) {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_valid = false;
+    m_directories.clear();
+}
+
+const AppIndexCache::CachedDirectory* AppIndexCache::findDirectory(std::string_view path) const {
+    for (const auto& dir : m_directories) {
+        if (dir.path == path) return &dir;
+    }
+    return nullptr;
+}
+
+bool AppIndexCache::write(const fs::path& path, const std::vector<AppIndexDirectory>& directories) {
+    if (path.empty()) return false;
+
+    std::string payload;
+    for (const auto& dir : directories) {
+        appendString(payload, dir.path);
+        append<int64_t>(payload, dir.mtime);
+        append<uint32_t>(payload, static_cast<uint32_t>(dir.records.size()));
+
+        for (const auto& record : dir.records) {
+            uint8_t flags = 0;
+            if (record.app.noDisplay) flags |= FLAG_NO_DISPLAY;
+            if (record.app.hidden) flags |= FLAG_HIDDEN;
+            if (record.isDirectory) flags |= FLAG_DIRECTORY;
+
+            appendString(payload, record.fileName);
+            append<int64_t>(payload, record.mtime);
+            append<uint64_t>(payload, record.size);
+            append<uint8_t>(payload, flags);
+            append<uint32_t>(payload, record.app.entryOffset);
+            appendString(payload, record.app.name);
+            appendString(payload, record.app.genericName);
+            appendString(payload, record.app.keywords);
+            appendString(payload, record.app.comment);
+            appendString(payload, record.app.exec);
+            appendString(payload, record.app.icon);
+            appendString(payload, record.app.onlyShowIn);
+            appendString(payload, record.app.notShowIn);
+            appendString(payload, record.app.categories);
+            appendString(payload, record.app.tryExec);
+        }
+    }
+
+    std::string header(MAGIC, sizeof(MAGIC));
+    append<uint32_t>(header, VERSION);
+    append<uint32_t>(header, static_cast<uint32_t>(directories.size()));
+    append<uint64_t>(header, payload.size());
+    append<uint64_t>(header, fnv1a(payload.data(), payload.size()));
+
+    try {
+        fs::create_directories(path.parent_path());
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: Could not create cache directory: " << e.what() << "\n";
+        return false;
+    }
+
+    fs::path tmpPath = path;
+    tmpPath += ".tmp." + std::to_string(::getpid());
+
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        out.write(header.data(), header.size());
+        out.write(payload.data(), payload.size());
+        if (!out.good()) {
+            out.close();
+            std::error_code ec;
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, path, ec);
+    if (ec) {
+        std::cerr << "Warning: Could not write app index: " << ec.message() << "\n";
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
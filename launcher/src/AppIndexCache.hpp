@@ -0,0 +1,105 @@
+#ifndef APP_INDEX_CACHE_HPP
+#define APP_INDEX_CACHE_HPP
+
+#include "DesktopApp.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// One parsed .desktop file as stored in the index, keyed by its mtime and size.
+// Subdirectories are recorded too, so an unchanged directory can be walked
+// recursively without listing it.
+struct AppIndexRecord {
+    std::string fileName;
+    int64_t mtime = 0;
+    uint64_t size = 0;
+    bool isDirectory = false;
+    DesktopApp app;
+};
+
+struct AppIndexDirectory {
+    std::string path;
+    // Desktop-file ID prefix; derived from the path, not stored
+    std::string idPrefix;
+    int64_t mtime = 0;
+    std::vector<AppIndexRecord> records;
+};
+
+// Versioned on-disk index of parsed desktop entries.
+//
+// The index is mmap'd read-only; lookups return views into the mapping so an
+// unchanged entry is only copied when it is actually handed to AppDatabase.
+// A missing, truncated, foreign-version or checksum-mismatched file is
+// treated as absent, which makes the caller fall back to a full rescan.
+class AppIndexCache {
+  public:
+    static constexpr uint32_t VERSION = 6;
+
+    struct CachedEntry {
+        std::string_view fileName;
+        int64_t mtime = 0;
+        uint64_t size = 0;
+        uint8_t flags = 0;
+        uint32_t entryOffset = 0;
+        std::string_view name;
+        std::string_view genericName;
+        std::string_view keywords;
+        std::string_view comment;
+        std::string_view exec;
+        std::string_view icon;
+        std::string_view onlyShowIn;
+        std::string_view notShowIn;
+        std::string_view categories;
+        std::string_view tryExec;
+
+        bool isDirectory() const;
+        DesktopApp toApp(const fs::path& directory) const;
+    };
+
+    struct CachedDirectory {
+        std::string_view path;
+        int64_t mtime = 0;
+        std::vector<CachedEntry> entries;
+        std::unordered_map<std::string_view, size_t> byFileName;
+
+        const CachedEntry* find(std::string_view fileName) const;
+    };
+
+    AppIndexCache() = default;
+    ~AppIndexCache();
+
+    AppIndexCache(const AppIndexCache&) = delete;
+    AppIndexCache& operator=(const AppIndexCache&) = delete;
+
+    // $XDG_CACHE_HOME/launcher/app-index.bin (or ~/.cache/launcher/app-index.bin)
+    static fs::path defaultPath();
+
+    // Map and validate an index file. Returns false if it is missing or unusable.
+    bool open(const fs::path& path);
+    bool isValid() const { return m_valid; }
+
+    const CachedDirectory* findDirectory(std::string_view path) const;
+    size_t directoryCount() const { return m_directories.size(); }
+
+    // Atomically replace the index at `path` (write to a temp file, then rename)
+    static bool write(const fs::path& path, const std::vector<AppIndexDirectory>& directories);
+
+  private:
+    bool parse();
+    void unmap();
+
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_valid = false;
+    std::vector<CachedDirectory> m_directories;
+};
+
+// Nanosecond mtime and size of a file, or false if it cannot be stat'ed
+bool statFile(const fs::path& path, int64_t& mtime, uint64_t& size);
+
+#endif // APP_INDEX_CACHE_HPP
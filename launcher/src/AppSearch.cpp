@@ -0,0 +1,59 @@
+#include "AppSearch.hpp"
+
+const std::vector<AppStore::AppId>& AppSearch::search(std::string_view query, const CancelToken& cancel) {
+    // IDs from before an update may have been retired
+    if (m_database.generation() != m_generation) {
+        m_generation = m_database.generation();
+        m_stack.clear();
+        m_cache.clear();
+    }
+    // Loading details adds the exec keys the cached sets were made without
+    if (m_database.pendingDetails() != m_pendingDetails) {
+        m_pendingDetails = m_database.pendingDetails();
+        m_stack.clear();
+        m_cache.clear();
+    }
+    // A launch only reorders; the match sets still hold
+    if (m_database.usageVersion() != m_usageVersion) {
+        m_usageVersion = m_database.usageVersion();
+        m_cache.clear();
+    }
+
+    AppDatabase::queryKey(query, m_key);
+    if (const auto* cached = m_cache.find(m_key)) {
+        m_lastScanned = 0;
+        return *cached;
+    }
+
+    auto [candidates, exact] = m_stack.lookup(query);
+    if (exact) {
+        m_lastScanned = 0;
+        return rank(query, *candidates, cancel);
+    }
+
+    std::vector<AppStore::AppId>& results = m_stack.push(query);
+    if (candidates) {
+        m_lastScanned = candidates->size();
+        m_database.refineApps(query, *candidates, results, cancel);
+    } else {
+        m_lastScanned = m_database.apps().size();
+        m_database.filterApps(query, results, cancel);
+    }
+
+    if (cancel.cancelled()) {
+        // A partial set must not be refined later
+        m_stack.pop();
+        return m_ranked;
+    }
+
+    return rank(query, results, cancel);
+}
+
+const std::vector<AppStore::AppId>& AppSearch::rank(std::string_view query, std::span<const AppStore::AppId> matches,
+                                                    const CancelToken& cancel) {
+    m_database.rankApps(query, matches, m_rankLimit, m_ranked, cancel);
+    if (!cancel.cancelled()) {
+        m_cache.insert(m_key, m_ranked);
+    }
+    return m_ranked;
+}
@@ -0,0 +1,58 @@
+#ifndef APP_SEARCH_HPP
+#define APP_SEARCH_HPP
+
+#include "AppDatabase.hpp"
+#include "QueryCache.hpp"
+#include "RefinementStack.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Search-as-you-type over an AppDatabase.
+//
+// Typing one more character only tests the apps the previous query matched,
+// and backspace returns a result set computed earlier without testing
+// anything. Those sets stay in display order and are ranked afresh (see
+// AppDatabase::rankApps). On top of that, the ranked answers of recent
+// queries are kept in a QueryCache under their AppDatabase::queryKey, so a
+// query seen before is answered without matching or ranking. Everything
+// cached is dropped when the database generation moves or more details
+// have been loaded.
+class AppSearch {
+  public:
+    // Results ranked by score before the rest fall back to display order
+    static constexpr size_t DEFAULT_RANK_LIMIT = 32;
+
+    explicit AppSearch(const AppDatabase& database, size_t rankLimit = DEFAULT_RANK_LIMIT)
+        : m_database(database), m_rankLimit(rankLimit) {}
+
+    // Matching IDs, best first, valid until the next call. If `cancel`
+    // fires meanwhile the result is incomplete and nothing is cached.
+    const std::vector<AppStore::AppId>& search(std::string_view query, const CancelToken& cancel = {});
+
+    // Apps tested by the last search: 0 on a cache hit, the previous result
+    // count when refining, everything on a fresh scan
+    size_t lastScanned() const { return m_lastScanned; }
+
+    const QueryCache<AppStore::AppId>& cache() const { return m_cache; }
+
+  private:
+    // Rank `matches` into m_ranked and cache the answer under m_key
+    const std::vector<AppStore::AppId>& rank(std::string_view query, std::span<const AppStore::AppId> matches,
+                                             const CancelToken& cancel);
+
+    const AppDatabase& m_database;
+    size_t m_rankLimit;
+    RefinementStack<AppStore::AppId> m_stack;
+    QueryCache<AppStore::AppId> m_cache;
+    std::string m_key;
+    std::vector<AppStore::AppId> m_ranked;
+    uint64_t m_generation = 0;
+    uint64_t m_usageVersion = 0;
+    size_t m_pendingDetails = 0;
+    size_t m_lastScanned = 0;
+};
+
+#endif // APP_SEARCH_HPP
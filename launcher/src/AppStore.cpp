@@ -0,0 +1,487 @@
+#include "AppStore.hpp"
+#include "FuzzyMatch.hpp"
+#include "SearchKey.hpp"
+#include <algorithm>
+
+namespace {
+
+// Calls fn for each non-empty entry of a ';'-separated list
+template <typename Fn>
+void forEachListEntry(std::string_view list, Fn fn) {
+    while (!list.empty()) {
+        size_t sep = list.find(';');
+        std::string_view entry = list.substr(0, sep);
+        list = sep == std::string_view::npos ? std::string_view{} : list.substr(sep + 1);
+        if (!entry.empty()) fn(entry);
+    }
+}
+
+// Program an Exec line runs: its first word, unquoted and without the
+// directory, skipping an `env VAR=value ...` prefix
+std::string_view execProgram(std::string_view exec) {
+    for (;;) {
+        const size_t start = exec.find_first_not_of(' ');
+        if (start == std::string_view::npos) return {};
+        exec.remove_prefix(start);
+
+        std::string_view word;
+        if (exec.front() == '"') {
+            const size_t close = exec.find('"', 1);
+            word = exec.substr(1, close == std::string_view::npos ? std::string_view::npos : close - 1);
+            exec.remove_prefix(close == std::string_view::npos ? exec.size() : close + 1);
+        } else {
+            word = exec.substr(0, exec.find(' '));
+            exec.remove_prefix(word.size());
+        }
+
+        const size_t slash = word.rfind('/');
+        if (slash != std::string_view::npos) word.remove_prefix(slash + 1);
+        if (word != "env" && word.find('=') == std::string_view::npos) return word;
+    }
+}
+
+// Keys of every field before EXEC, each followed by the separator
+void appendListKeys(const DesktopApp& app, std::string& out) {
+    for (std::string_view text : {std::string_view(app.name), std::string_view(app.genericName),
+                                  std::string_view(app.keywords), std::string_view(app.comment)}) {
+        SearchKey::append(text, out);
+        out.push_back(SearchFields::SEPARATOR);
+    }
+}
+
+bool isAsciiUpper(char c) {
+    return c >= 'A' && c <= 'Z';
+}
+
+bool isAsciiLower(char c) {
+    return c >= 'a' && c <= 'z';
+}
+
+// Bytes of the UTF-8 character starting `text`
+size_t leadingCharLength(std::string_view text) {
+    const auto lead = static_cast<unsigned char>(text.front());
+    const size_t length = lead < 0xC0 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+    return std::min(length, text.size());
+}
+
+// Index the words of `name` and their initials under `id`. Words break at
+// ASCII punctuation and spaces, and again at camelCase humps, so
+// "LibreOffice" yields the words "libreoffice" and "office" and the
+// initials "lo".
+void addNameTerms(std::string_view name, uint32_t id, PrefixTrie& index) {
+    thread_local std::string term;
+    thread_local std::string initials;
+    initials.clear();
+    size_t parts = 0;
+
+    size_t pos = 0;
+    while (pos < name.size()) {
+        const auto isWordChar = [&](size_t i) {
+            const char c = name[i];
+            return SearchFields::isWordByte(static_cast<unsigned char>(isAsciiUpper(c) ? c - 'A' + 'a' : c));
+        };
+        if (!isWordChar(pos)) {
+            ++pos;
+            continue;
+        }
+
+        size_t end = pos;
+        while (end < name.size() && isWordChar(end)) ++end;
+        const std::string_view word = name.substr(pos, end - pos);
+
+        for (size_t i = 0; i < word.size(); ++i) {
+            // A hump is an upper-case letter after a lower-case one, or the
+            // last capital of a run followed by lower case ("XMLEditor")
+            const bool hump = i > 0 && isAsciiUpper(word[i]) &&
+                              (isAsciiLower(word[i - 1]) ||
+                               (isAsciiUpper(word[i - 1]) && i + 1 < word.size() && isAsciiLower(word[i + 1])));
+            if (i != 0 && !hump) continue;
+
+            SearchKey::assign(word.substr(i), term);
+            index.add(term, id, static_cast<uint8_t>(NameTerm::WORD));
+            initials.append(word.substr(i, leadingCharLength(word.substr(i))));
+            ++parts;
+        }
+        pos = end;
+    }
+
+    if (parts >= 2) {
+        SearchKey::assign(initials, term);
+        index.add(term, id, static_cast<uint8_t>(NameTerm::ACRONYM));
+    }
+}
+
+} // namespace
+
+StringPool::StringPool() {
+    m_spans.push_back({});
+    m_index.emplace(std::string(), 0);
+}
+
+uint32_t StringPool::intern(std::string_view str) {
+    auto it = m_index.find(str);
+    if (it != m_index.end()) return it->second;
+
+    uint32_t id = static_cast<uint32_t>(m_spans.size());
+    m_spans.push_back({static_cast<uint32_t>(m_data.size()), static_cast<uint32_t>(str.size())});
+    m_data.append(str);
+    m_index.emplace(std::string(str), id);
+    return id;
+}
+
+std::string_view StringPool::view(uint32_t id) const {
+    const auto& span = m_spans[id];
+    return {m_data.data() + span.offset, span.length};
+}
+
+size_t AppStore::assign(const std::vector<DesktopApp>& apps) {
+    // Build into a fresh store laid out like this one, so unchanged entries
+    // keep their slot while every arena is rewritten without dead bytes.
+    // The other entries fill the lowest slots nothing kept, so the slots
+    // never outnumber the most apps ever listed.
+    AppStore next;
+    std::vector<AppId> ids(apps.size(), INVALID_ID);
+    std::vector<uint8_t> kept(m_alive.size(), 0);
+    size_t changed = 0;
+    size_t matched = 0;
+
+    for (size_t i = 0; i < apps.size(); ++i) {
+        AppId old = find(apps[i].id);
+        if (old == INVALID_ID) continue;
+
+        ++matched;
+        if (equals(old, apps[i])) {
+            ids[i] = old;
+            kept[old] = 1;
+        }
+    }
+
+    // Every slot stays, empty if retired, so IDs held from before can still
+    // be read and their versions compared
+    next.growSlots(m_alive.size());
+    std::copy(m_versions.begin(), m_versions.end(), next.m_versions.begin());
+    next.m_lastVersion = m_lastVersion;
+
+    AppId nextFree = 0;
+    for (size_t i = 0; i < apps.size(); ++i) {
+        const bool issued = ids[i] == INVALID_ID;
+        if (issued) {
+            while (nextFree < kept.size() && kept[nextFree]) ++nextFree;
+            ids[i] = nextFree++;
+            ++changed;
+        }
+        next.append(apps[i], ids[i]);
+        if (issued) next.m_versions[ids[i]] = ++next.m_lastVersion;
+    }
+
+    // Entries whose desktop-file ID is gone altogether
+    changed += size() - matched;
+
+    // Highest first, so upsert() takes the lowest
+    for (AppId id = static_cast<AppId>(next.m_alive.size()); id-- > 0;) {
+        if (!next.m_alive[id]) next.m_freeIds.push_back(id);
+    }
+
+    next.m_order.reserve(next.m_byDesktopId.size());
+    for (const auto& [desktopId, id] : next.m_byDesktopId) {
+        next.m_order.push_back(id);
+    }
+    std::sort(next.m_order.begin(), next.m_order.end(),
+              [&](AppId a, AppId b) { return next.less(a, b); });
+    next.wordIndex();
+
+    *this = std::move(next);
+    return changed;
+}
+
+bool AppStore::upsert(const DesktopApp& app) {
+    AppId old = find(app.id);
+    if (old != INVALID_ID && equals(old, app)) return false;
+
+    // Taken before the old version is retired, so it never gets its own
+    // ID back
+    AppId id = static_cast<AppId>(m_alive.size());
+    if (!m_freeIds.empty()) {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    if (old != INVALID_ID) {
+        remove(app.id);
+    }
+
+    append(app, id);
+    m_versions[id] = ++m_lastVersion;
+    insertSorted(id);
+    compactIfSparse();
+    return true;
+}
+
+bool AppStore::remove(std::string_view desktopId) {
+    auto it = m_byDesktopId.find(desktopId);
+    if (it == m_byDesktopId.end()) return false;
+
+    // The retired slot keeps its data until it is reused or the arenas are
+    // compacted, so items built from it can still be rebound until then
+    AppId id = it->second;
+    eraseSorted(id);
+    retireData(id);
+    m_alive[id] = 0;
+    m_freeIds.push_back(id);
+    m_byDesktopId.erase(it);
+    compactIfSparse();
+    return true;
+}
+
+AppStore::AppId AppStore::find(std::string_view desktopId) const {
+    auto it = m_byDesktopId.find(desktopId);
+    return it == m_byDesktopId.end() ? INVALID_ID : it->second;
+}
+
+const PackedKeys& AppStore::sortedKeys() const {
+    if (m_sortedKeysStale) {
+        m_sortedKeys.clear();
+        m_sortedKeys.reserve(m_order.size(), m_keys.size());
+        for (AppId id : m_order) {
+            m_sortedKeys.append(searchKeys(id));
+        }
+        m_sortedKeysStale = false;
+    }
+    return m_sortedKeys;
+}
+
+const PrefixTrie& AppStore::wordIndex() const {
+    if (m_wordIndexStale) {
+        m_wordIndex.clear();
+        for (AppId id : m_order) {
+            addNameTerms(name(id), id, m_wordIndex);
+        }
+        m_wordIndex.build();
+        m_wordIndexStale = false;
+    }
+    return m_wordIndex;
+}
+
+std::span<const uint32_t> AppStore::categories(AppId id) const {
+    const auto& span = m_categoryLists[id];
+    return {m_categoryIds.data() + span.offset, span.length};
+}
+
+void AppStore::setDetails(AppId id, const DesktopApp& details) {
+    m_deadBytes += m_execs[id].length + m_searchKeys[id].length + m_categoryLists[id].length * sizeof(uint32_t);
+    appendDetails(id, details);
+    setSearchKeys(id, listKeys(id), details.exec);
+    m_detailsLoaded[id] = 1;
+    compactIfSparse();
+}
+
+DesktopApp AppStore::materialize(AppId id) const {
+    DesktopApp app;
+    app.id = std::string(desktopId(id));
+    app.name = std::string(name(id));
+    app.exec = std::string(exec(id));
+    app.icon = std::string(icon(id));
+    app.desktopFile = std::string(desktopFile(id));
+    for (uint32_t category : categories(id)) {
+        app.categories.append(categoryName(category)).push_back(';');
+    }
+    app.entryOffset = entryOffset(id);
+    app.hasExec = true;
+    app.detailsLoaded = hasDetails(id);
+    return app;
+}
+
+void AppStore::retireData(AppId id) {
+    m_deadBytes += m_names[id].length + m_desktopFiles[id].length + m_desktopIds[id].length + m_execs[id].length +
+                   m_searchKeys[id].length + m_categoryLists[id].length * sizeof(uint32_t);
+}
+
+void AppStore::compactIfSparse() {
+    const size_t total = m_text.size() + m_keys.size() + m_categoryIds.size() * sizeof(uint32_t);
+    if (m_deadBytes * 2 <= total) return;
+
+    std::string text;
+    std::string keys;
+    std::vector<uint32_t> categoryIds;
+    text.reserve(m_text.size() / 2);
+    keys.reserve(m_keys.size() / 2);
+    categoryIds.reserve(m_categoryIds.size() / 2);
+
+    auto moveText = [&](Span& span) {
+        const std::string_view str = this->text(span);
+        span.offset = static_cast<uint32_t>(text.size());
+        text.append(str);
+    };
+    for (AppId id = 0; id < m_alive.size(); ++id) {
+        // Retired slots are left empty
+        if (!m_alive[id]) {
+            m_names[id] = m_desktopFiles[id] = m_desktopIds[id] = m_execs[id] = m_searchKeys[id] = {};
+            m_categoryLists[id] = {};
+            for (const auto& info : SearchFields::TABLE) m_fieldKeys[fieldSlot(id, info.field)] = {};
+            continue;
+        }
+        moveText(m_names[id]);
+        moveText(m_desktopFiles[id]);
+        moveText(m_desktopIds[id]);
+        moveText(m_execs[id]);
+
+        // The field keys lie within the search keys and move with them
+        Span& searchKeys = m_searchKeys[id];
+        const auto offset = static_cast<uint32_t>(keys.size());
+        keys.append(this->keys(searchKeys));
+        for (const auto& info : SearchFields::TABLE) {
+            Span& fieldKey = m_fieldKeys[fieldSlot(id, info.field)];
+            fieldKey.offset = fieldKey.offset - searchKeys.offset + offset;
+        }
+        searchKeys.offset = offset;
+
+        Span& categoryList = m_categoryLists[id];
+        const auto first = m_categoryIds.begin() + categoryList.offset;
+        categoryList.offset = static_cast<uint32_t>(categoryIds.size());
+        categoryIds.insert(categoryIds.end(), first, first + categoryList.length);
+    }
+
+    m_text.swap(text);
+    m_keys.swap(keys);
+    m_categoryIds.swap(categoryIds);
+    m_deadBytes = 0;
+}
+
+AppStore::Span AppStore::appendText(std::string_view str) {
+    Span span{static_cast<uint32_t>(m_text.size()), static_cast<uint32_t>(str.size())};
+    m_text.append(str);
+    return span;
+}
+
+void AppStore::growSlots(size_t slots) {
+    if (slots <= m_alive.size()) return;
+
+    m_names.resize(slots);
+    m_searchKeys.resize(slots);
+    m_masks.resize(slots);
+    m_fieldKeys.resize(slots * SearchFields::TABLE.size());
+    m_execs.resize(slots);
+    m_desktopFiles.resize(slots);
+    m_desktopIds.resize(slots);
+    m_categoryLists.resize(slots);
+    m_icons.resize(slots);
+    m_entryOffsets.resize(slots);
+    m_detailsLoaded.resize(slots);
+    m_alive.resize(slots);
+    m_versions.resize(slots);
+}
+
+AppStore::AppId AppStore::append(const DesktopApp& app, AppId id) {
+    growSlots(static_cast<size_t>(id) + 1);
+
+    m_names[id] = appendText(app.name);
+    m_desktopFiles[id] = appendText(app.desktopFile);
+    m_desktopIds[id] = appendText(app.id);
+    m_icons[id] = m_iconPool.intern(app.icon);
+
+    thread_local std::string keys;
+    keys.clear();
+    appendListKeys(app, keys);
+    setSearchKeys(id, keys, app.exec);
+
+    appendDetails(id, app);
+    m_entryOffsets[id] = app.entryOffset;
+    m_detailsLoaded[id] = app.detailsLoaded;
+
+    m_alive[id] = 1;
+    m_byDesktopId[app.id] = id;
+    return id;
+}
+
+std::string_view AppStore::listKeys(AppId id) const {
+    const std::string_view keys = searchKeys(id);
+    return keys.substr(0, keys.rfind(SearchFields::SEPARATOR) + 1);
+}
+
+void AppStore::setSearchKeys(AppId id, std::string_view listKeys, std::string_view exec) {
+    // Assembled aside, since `listKeys` may point into m_keys
+    thread_local std::string keys;
+    keys.assign(listKeys);
+    SearchKey::append(execProgram(exec), keys);
+
+    const auto offset = static_cast<uint32_t>(m_keys.size());
+    m_keys.append(keys);
+    m_searchKeys[id] = {offset, static_cast<uint32_t>(keys.size())};
+    SearchMasks& masks = m_masks[id];
+    masks = SearchMasks{};
+    masks.all = FuzzyMatch::charMask(keys);
+
+    size_t start = 0;
+    for (const auto& info : SearchFields::TABLE) {
+        const size_t end = std::min(keys.find(SearchFields::SEPARATOR, start), keys.size());
+        m_fieldKeys[fieldSlot(id, info.field)] = {static_cast<uint32_t>(offset + start),
+                                                  static_cast<uint32_t>(end - start)};
+        const std::string_view key = fieldKey(id, info.field);
+        masks.fields[static_cast<size_t>(info.field)] = FuzzyMatch::charMask(key);
+
+        if (info.mode == SearchFields::MatchMode::WORD_PREFIX) {
+            for (size_t pos = 0; pos < key.size(); ++pos) {
+                if (SearchFields::startsWord(key, pos)) masks.wordStarts |= SearchFields::wordStartBit(key, pos);
+            }
+        }
+        start = std::min(end + 1, keys.size());
+    }
+    m_sortedKeysStale = true;
+}
+
+void AppStore::appendDetails(AppId id, const DesktopApp& app) {
+    m_execs[id] = appendText(app.exec);
+
+    Span categoryList{static_cast<uint32_t>(m_categoryIds.size()), 0};
+    forEachListEntry(app.categories, [&](std::string_view category) {
+        m_categoryIds.push_back(m_categoryPool.intern(category));
+        ++categoryList.length;
+    });
+    m_categoryLists[id] = categoryList;
+}
+
+bool AppStore::equals(AppId id, const DesktopApp& app) const {
+    if (name(id) != app.name || icon(id) != app.icon || desktopFile(id) != app.desktopFile) {
+        return false;
+    }
+
+    thread_local std::string keys;
+    keys.clear();
+    appendListKeys(app, keys);
+    if (listKeys(id) != keys) return false;
+
+    // Details can only be compared once both sides have them
+    if (!hasDetails(id) || !app.detailsLoaded) return true;
+    if (exec(id) != app.exec) return false;
+
+    auto stored = categories(id);
+    size_t index = 0;
+    bool same = true;
+    forEachListEntry(app.categories, [&](std::string_view category) {
+        same = same && index < stored.size() && categoryName(stored[index]) == category;
+        ++index;
+    });
+    return same && index == stored.size();
+}
+
+// Same order as DesktopApp::operator<
+bool AppStore::less(AppId a, AppId b) const {
+    if (name(a) != name(b)) return name(a) < name(b);
+    return desktopFile(a) < desktopFile(b);
+}
+
+void AppStore::insertSorted(AppId id) {
+    auto pos = std::lower_bound(m_order.begin(), m_order.end(), id,
+                                [&](AppId a, AppId b) { return less(a, b); });
+    m_order.insert(pos, id);
+    m_sortedKeysStale = true;
+    m_wordIndexStale = true;
+}
+
+void AppStore::eraseSorted(AppId id) {
+    auto pos = std::find(m_order.begin(), m_order.end(), id);
+    if (pos != m_order.end()) {
+        m_order.erase(pos);
+        m_sortedKeysStale = true;
+        m_wordIndexStale = true;
+    }
+}
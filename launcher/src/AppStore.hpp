@@ -0,0 +1,287 @@
+#ifndef APP_STORE_HPP
+#define APP_STORE_HPP
+
+#include "DesktopApp.hpp"
+#include "PackedKeys.hpp"
+#include "PrefixTrie.hpp"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Lets string-keyed maps be probed with a string_view without a copy
+struct StringViewHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+};
+
+// Fields an app is searched by, in the order their keys are stored
+enum class SearchField : uint8_t {
+    NAME,
+    GENERIC_NAME,
+    KEYWORDS,
+    COMMENT,
+    // Basename of the program Exec runs; empty until details are loaded
+    EXEC,
+};
+
+namespace SearchFields {
+
+enum class MatchMode : uint8_t {
+    // The query's bytes in order, anywhere (see FuzzyMatch)
+    FUZZY,
+    // The query as one run starting a word. Used for prose, where nearly
+    // every short query is a subsequence of a sentence.
+    WORD_PREFIX,
+};
+
+struct FieldInfo {
+    SearchField field;
+    MatchMode mode;
+    // Added to a match's FuzzyMatch score (16 points per matched byte), so
+    // a name match outranks an equally good match anywhere else
+    int bias;
+};
+
+inline constexpr std::array<FieldInfo, 5> TABLE = {{
+    {SearchField::NAME, MatchMode::FUZZY, 0},
+    {SearchField::GENERIC_NAME, MatchMode::FUZZY, -16},
+    {SearchField::KEYWORDS, MatchMode::WORD_PREFIX, -24},
+    {SearchField::COMMENT, MatchMode::WORD_PREFIX, -40},
+    {SearchField::EXEC, MatchMode::FUZZY, -24},
+}};
+
+constexpr bool inFieldOrder() {
+    for (size_t i = 0; i < TABLE.size(); ++i) {
+        if (static_cast<size_t>(TABLE[i].field) != i) return false;
+    }
+    return true;
+}
+static_assert(inFieldOrder(), "the field table must follow SearchField order");
+
+// Between the field keys of an app. Desktop entry values are single lines,
+// so no key contains it and no substring match can span two fields.
+inline constexpr char SEPARATOR = '\n';
+
+// Whether a byte of a key belongs to a word; keys are lower case, and
+// anything outside ASCII counts as a letter
+inline bool isWordByte(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+// Whether byte `pos` of a key begins a word, as WORD_PREFIX requires
+inline bool startsWord(std::string_view key, size_t pos) {
+    return pos == 0 || !isWordByte(static_cast<unsigned char>(key[pos - 1]));
+}
+
+// One of 64 bits, picked by the two bytes at `pos` (the second one 0 past
+// the end). An app's word-start mask has the bit of every word in its
+// WORD_PREFIX fields, so a query whose bit is missing cannot start one.
+inline uint64_t wordStartBit(std::string_view key, size_t pos) {
+    const uint32_t first = static_cast<unsigned char>(key[pos]);
+    const uint32_t second = pos + 1 < key.size() ? static_cast<unsigned char>(key[pos + 1]) : 0;
+    return uint64_t{1} << (((first << 8 | second) * 0x9E3779B1u) >> 26);
+}
+
+} // namespace SearchFields
+
+// Kinds of terms in AppStore::wordIndex(), used as PrefixTrie tags
+enum class NameTerm : uint8_t {
+    // A word of the name, or the rest of it from a camelCase hump
+    // ("office" in LibreOffice)
+    WORD,
+    // The initials of those words ("gimp", "lo" for LibreOffice)
+    ACRONYM,
+};
+
+// Deduplicating string table; ID 0 is always the empty string
+class StringPool {
+  public:
+    StringPool();
+
+    uint32_t intern(std::string_view str);
+    std::string_view view(uint32_t id) const;
+    size_t size() const { return m_spans.size(); }
+
+  private:
+    struct Span {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    std::string m_data;
+    std::vector<Span> m_spans;
+    std::unordered_map<std::string, uint32_t, StringViewHash, std::equal_to<>> m_index;
+};
+
+// Structure-of-arrays storage for the listed applications.
+//
+// Every string lives in one of a few contiguous arenas and is addressed by
+// offset, so an app costs a handful of integers instead of five heap
+// strings. The search keys of the names (see SearchKey) are also packed in
+// display order, so an exact filter pass is one substring scan over that
+// buffer, and each key's FuzzyMatch mask is kept next to it. Icons and
+// categories are interned.
+//
+// An app's search keys are the keys of every SearchField, stored back to
+// back and joined by SearchFields::SEPARATOR, so all fields are searched
+// in one pass over one contiguous run of bytes. Only the name is kept as
+// text; the other fields exist only as keys.
+//
+// The arenas only grow: upsert(), remove() and setDetails() leave the bytes
+// of what they retire or replace behind, and once those outnumber the live
+// ones the arenas are rewritten without them.
+//
+// An AppId names one immutable version of an entry. It never moves when
+// other apps are added or removed; a change to what the list shows retires
+// the old ID and issues a new one. Filling in deferred details keeps the
+// ID. Retired IDs are reused by later changes, so there are about as many
+// slots as apps, and each issue of an ID comes with a new version(): views
+// built before a change (AppDatabase::generation() moves) tell a reused ID
+// from the app they showed by comparing versions. Views returned by the
+// accessors stay valid until the store is next modified.
+class AppStore {
+  public:
+    using AppId = uint32_t;
+    static constexpr AppId INVALID_ID = UINT32_MAX;
+
+    // Replace the contents, keeping the IDs of entries that did not change
+    // and giving the others the lowest free ones. Also compacts the arenas.
+    // Returns the number of entries added, replaced or removed.
+    size_t assign(const std::vector<DesktopApp>& apps);
+
+    // Insert an app, retiring any previous version with the same desktop-file
+    // ID. Returns false if an identical version is already stored.
+    bool upsert(const DesktopApp& app);
+    bool remove(std::string_view desktopId);
+
+    // Live IDs sorted by name
+    const std::vector<AppId>& sorted() const { return m_order; }
+    size_t size() const { return m_order.size(); }
+    bool contains(AppId id) const { return id < m_alive.size() && m_alive[id]; }
+    // One past the highest ID issued, for tables indexed by AppId
+    AppId idLimit() const { return static_cast<AppId>(m_alive.size()); }
+    AppId find(std::string_view desktopId) const;
+    // Unique to the issue of `id`: changes when the ID is reused for another
+    // app, not when its details are filled in
+    uint32_t version(AppId id) const { return m_versions[id]; }
+
+    std::string_view name(AppId id) const { return text(m_names[id]); }
+    std::string_view nameKey(AppId id) const { return fieldKey(id, SearchField::NAME); }
+    // Keys of all SearchFields, name first, joined by SearchFields::SEPARATOR
+    std::string_view searchKeys(AppId id) const { return keys(m_searchKeys[id]); }
+    std::string_view fieldKey(AppId id, SearchField field) const { return keys(m_fieldKeys[fieldSlot(id, field)]); }
+    // FuzzyMatch::charMask() of searchKeys() and of each field's key, for
+    // rejecting non-matches before any key is read
+    uint64_t searchMask(AppId id) const { return m_masks[id].all; }
+    uint64_t fieldMask(AppId id, SearchField field) const {
+        return m_masks[id].fields[static_cast<size_t>(field)];
+    }
+    // SearchFields::wordStartBit() of every word in the WORD_PREFIX fields
+    uint64_t wordStartMask(AppId id) const { return m_masks[id].wordStarts; }
+
+    // searchKeys() in sorted() order. Rebuilt by the first call after a change.
+    const PackedKeys& sortedKeys() const;
+    // Words and initials of every live name (see NameTerm), as keys. Built
+    // by assign(), and rebuilt by the first call after any other change.
+    const PrefixTrie& wordIndex() const;
+    std::string_view exec(AppId id) const { return text(m_execs[id]); }
+    std::string_view icon(AppId id) const { return m_iconPool.view(m_icons[id]); }
+    std::string_view desktopFile(AppId id) const { return text(m_desktopFiles[id]); }
+    std::string_view desktopId(AppId id) const { return text(m_desktopIds[id]); }
+
+    // Whether exec and categories are known yet (see AppDatabase::ensureDetails)
+    bool hasDetails(AppId id) const { return m_detailsLoaded[id] != 0; }
+    uint32_t entryOffset(AppId id) const { return m_entryOffsets[id]; }
+    void setDetails(AppId id, const DesktopApp& details);
+
+    // Interned category IDs of an app; resolve them with categoryName()
+    std::span<const uint32_t> categories(AppId id) const;
+    std::string_view categoryName(uint32_t category) const { return m_categoryPool.view(category); }
+    size_t categoryCount() const { return m_categoryPool.size(); }
+
+    // Rebuild the DesktopApp an ID was created from. Desktop lists and the
+    // searched fields other than the name are not stored, and categories
+    // come back normalized to "A;B;".
+    DesktopApp materialize(AppId id) const;
+
+  private:
+    struct Span {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    // Every mask of one app in one cache line, so a filter pass rejecting
+    // an app reads nothing else about it
+    struct alignas(64) SearchMasks {
+        uint64_t all = 0;
+        std::array<uint64_t, SearchFields::TABLE.size()> fields{};
+        uint64_t wordStarts = 0;
+    };
+
+    std::string_view text(Span span) const { return {m_text.data() + span.offset, span.length}; }
+    std::string_view keys(Span span) const { return {m_keys.data() + span.offset, span.length}; }
+    static size_t fieldSlot(AppId id, SearchField field) {
+        return static_cast<size_t>(id) * SearchFields::TABLE.size() + static_cast<size_t>(field);
+    }
+    Span appendText(std::string_view str);
+    // Count the arena bytes of `id` as dead
+    void retireData(AppId id);
+    // Rewrite the arenas without dead bytes once they are most of them
+    void compactIfSparse();
+    // Make room for IDs below `slots`, as retired slots
+    void growSlots(size_t slots);
+    AppId append(const DesktopApp& app, AppId id);
+    void appendDetails(AppId id, const DesktopApp& app);
+    // The search keys of every field before EXEC, separator included
+    std::string_view listKeys(AppId id) const;
+    // Store `listKeys` followed by the key of the program `exec` runs as
+    // the search keys of `id`
+    void setSearchKeys(AppId id, std::string_view listKeys, std::string_view exec);
+    bool equals(AppId id, const DesktopApp& app) const;
+    bool less(AppId a, AppId b) const;
+    void insertSorted(AppId id);
+    void eraseSorted(AppId id);
+
+    // Arenas
+    std::string m_text;
+    std::string m_keys;
+    std::vector<uint32_t> m_categoryIds;
+    // Bytes of the arenas no live span refers to
+    size_t m_deadBytes = 0;
+
+    // Per-slot columns, indexed by AppId
+    std::vector<Span> m_names;
+    std::vector<Span> m_searchKeys;
+    std::vector<SearchMasks> m_masks;
+    // SearchFields::TABLE.size() entries per slot, see fieldSlot()
+    std::vector<Span> m_fieldKeys;
+    std::vector<Span> m_execs;
+    std::vector<Span> m_desktopFiles;
+    std::vector<Span> m_desktopIds;
+    std::vector<Span> m_categoryLists;
+    std::vector<uint32_t> m_icons;
+    std::vector<uint32_t> m_entryOffsets;
+    std::vector<uint8_t> m_detailsLoaded;
+    std::vector<uint8_t> m_alive;
+    std::vector<uint32_t> m_versions;
+    uint32_t m_lastVersion = 0;
+    // Slots below m_alive.size() that are not alive, reused by upsert()
+    std::vector<AppId> m_freeIds;
+
+    StringPool m_iconPool;
+    StringPool m_categoryPool;
+
+    std::unordered_map<std::string, AppId, StringViewHash, std::equal_to<>> m_byDesktopId;
+    std::vector<AppId> m_order;
+
+    mutable PackedKeys m_sortedKeys;
+    mutable bool m_sortedKeysStale = true;
+    mutable PrefixTrie m_wordIndex;
+    mutable bool m_wordIndexStale = true;
+};
+
+#endif // APP_STORE_HPP
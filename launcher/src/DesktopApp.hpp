@@ -0,0 +1,50 @@
+#ifndef DESKTOP_APP_HPP
+#define DESKTOP_APP_HPP
+
+#include <cstdint>
+#include <string>
+
+struct DesktopApp {
+    // Desktop-file ID: path below the applications dir with '/' turned into '-'
+    std::string id;
+    std::string name;
+    // Searched along with the name (see SearchField)
+    std::string genericName;
+    // Raw ';'-separated Keywords value
+    std::string keywords;
+    std::string comment;
+    std::string exec;
+    std::string icon;
+    std::string desktopFile;
+    // Raw ';'-separated Categories value
+    std::string categories;
+    // Program that must exist for the entry to be shown
+    std::string tryExec;
+    // Raw ';'-separated desktop lists, matched against XDG_CURRENT_DESKTOP
+    std::string onlyShowIn;
+    std::string notShowIn;
+    // Byte offset of the [Desktop Entry] header, so details can be read later
+    // without rescanning whatever precedes it
+    uint32_t entryOffset = 0;
+    bool hasExec = false;
+    // False while only the list fields have been parsed; see
+    // DesktopEntryParser::parseListFields()
+    bool detailsLoaded = true;
+    bool noDisplay = false;
+    bool hidden = false;
+
+    // Ties on name are broken by path so the order never depends on load order
+    bool operator<(const DesktopApp& other) const {
+        if (name != other.name) return name < other.name;
+        return desktopFile < other.desktopFile;
+    }
+
+    bool operator==(const DesktopApp& other) const = default;
+
+    // Whether this entry should be listed in the launcher
+    bool isVisible() const {
+        return !name.empty() && hasExec && !noDisplay && !hidden;
+    }
+};
+
+#endif // DESKTOP_APP_HPP
@@ -0,0 +1,130 @@
+#include "DesktopEntryParser.hpp"
+#include "DesktopEntryLines.hpp"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// Desktop files are a few KB; a group this large is not a real entry
+constexpr size_t MAX_FILE_SIZE = 1 << 20;
+
+// Per-thread read buffer. It only grows, and unlike std::string it is never
+// zero-filled, so reusing it costs nothing per file.
+struct ReadBuffer {
+    std::unique_ptr<char[]> data;
+    size_t capacity = 0;
+
+    void reserve(size_t size) {
+        if (size <= capacity) return;
+        auto grown = std::make_unique<char[]>(size);
+        if (capacity > 0) std::memcpy(grown.get(), data.get(), capacity);
+        data = std::move(grown);
+        capacity = size;
+    }
+};
+
+// The first read; most entries fit in it
+constexpr size_t FIRST_READ = 4 << 10;
+
+// Read `filepath` from `offset` through its [Desktop Entry] group. Each read
+// is as large as everything before it, and reading stops at the end of the
+// file or once the group has ended, so the actions and other groups after
+// it are skipped. There is no fstat: a short read from a regular file means
+// end of file, so a typical entry costs exactly open, read and close.
+std::optional<std::string_view> readFile(const fs::path& filepath, size_t offset = 0) {
+    thread_local ReadBuffer buffer;
+
+    int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return std::nullopt;
+
+    size_t total = 0;
+    size_t want = FIRST_READ;
+    for (;;) {
+        buffer.reserve(total + want);
+        ssize_t got = ::pread(fd, buffer.data.get() + total, want, static_cast<off_t>(offset + total));
+        if (got < 0) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        total += static_cast<size_t>(got);
+        if (static_cast<size_t>(got) < want) break;
+        if (DesktopEntryLines::reachesGroupEnd({buffer.data.get(), total})) break;
+
+        if (total > MAX_FILE_SIZE) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        want = std::min(total, MAX_FILE_SIZE + 1 - total);
+    }
+    ::close(fd);
+
+    return std::string_view(buffer.data.get(), total);
+}
+
+std::optional<DesktopApp> parseWith(const fs::path& filepath, DesktopEntryParser::Fields fields) {
+    auto data = readFile(filepath);
+    if (!data) return std::nullopt;
+
+    DesktopApp app;
+    app.desktopFile = filepath.string();
+    DesktopEntryParser::parseBuffer(*data, app, fields);
+    return app;
+}
+
+} // namespace
+
+std::optional<DesktopApp> DesktopEntryParser::parseFile(const fs::path& filepath) {
+    return parseWith(filepath, Fields::ALL);
+}
+
+std::optional<DesktopApp> DesktopEntryParser::parseListFields(const fs::path& filepath) {
+    auto app = parseWith(filepath, Fields::LIST);
+    if (app) app->detailsLoaded = false;
+    return app;
+}
+
+bool DesktopEntryParser::parseDetails(const fs::path& filepath, DesktopApp& app) {
+    auto data = readFile(filepath, app.entryOffset);
+
+    // If the file was rewritten since the offset was taken, start over
+    if (data && !data->starts_with(DesktopEntryLines::GROUP)) {
+        data = readFile(filepath);
+    }
+    if (!data) return false;
+
+    parseBuffer(*data, app, Fields::DETAILS);
+    app.detailsLoaded = true;
+    return true;
+}
+
+void DesktopEntryParser::parseBuffer(std::string_view data, DesktopApp& app, Fields fields) {
+    const bool list = fields != Fields::DETAILS;
+    const bool details = fields != Fields::LIST;
+
+    const size_t header = DesktopEntryLines::forEachEntry(data, [&](std::string_view key, std::string_view value) {
+        switch (DesktopKeys::lookup(key)) {
+            case DesktopKey::NAME: if (list) app.name.assign(value); break;
+            case DesktopKey::GENERIC_NAME: if (list) app.genericName.assign(value); break;
+            case DesktopKey::KEYWORDS: if (list) app.keywords.assign(value); break;
+            case DesktopKey::COMMENT: if (list) app.comment.assign(value); break;
+            case DesktopKey::ICON: if (list) app.icon.assign(value); break;
+            case DesktopKey::NO_DISPLAY: if (list) app.noDisplay = value == "true"; break;
+            case DesktopKey::HIDDEN: if (list) app.hidden = value == "true"; break;
+            case DesktopKey::ONLY_SHOW_IN: if (list) app.onlyShowIn.assign(value); break;
+            case DesktopKey::NOT_SHOW_IN: if (list) app.notShowIn.assign(value); break;
+            case DesktopKey::TRY_EXEC: if (list) app.tryExec.assign(value); break;
+            case DesktopKey::EXEC:
+                if (list) app.hasExec = !value.empty();
+                if (details) app.exec.assign(value);
+                break;
+            case DesktopKey::CATEGORIES: if (details) app.categories.assign(value); break;
+            case DesktopKey::UNKNOWN: break;
+        }
+    });
+    if (header != std::string_view::npos && list) {
+        app.entryOffset = static_cast<uint32_t>(header);
+    }
+}
@@ -0,0 +1,132 @@
+#ifndef DESKTOP_ENTRY_PARSER_HPP
+#define DESKTOP_ENTRY_PARSER_HPP
+
+#include "DesktopApp.hpp"
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// Keys of the [Desktop Entry] group the launcher cares about
+enum class DesktopKey : uint8_t {
+    UNKNOWN,
+    NAME,
+    GENERIC_NAME,
+    KEYWORDS,
+    COMMENT,
+    EXEC,
+    ICON,
+    NO_DISPLAY,
+    HIDDEN,
+    ONLY_SHOW_IN,
+    NOT_SHOW_IN,
+    CATEGORIES,
+    TRY_EXEC,
+};
+
+namespace DesktopKeys {
+
+struct KeyName {
+    std::string_view name;
+    DesktopKey key;
+};
+
+inline constexpr std::array<KeyName, 12> KNOWN = {{
+    {"Name", DesktopKey::NAME},
+    {"GenericName", DesktopKey::GENERIC_NAME},
+    {"Keywords", DesktopKey::KEYWORDS},
+    {"Comment", DesktopKey::COMMENT},
+    {"Exec", DesktopKey::EXEC},
+    {"Icon", DesktopKey::ICON},
+    {"NoDisplay", DesktopKey::NO_DISPLAY},
+    {"Hidden", DesktopKey::HIDDEN},
+    {"OnlyShowIn", DesktopKey::ONLY_SHOW_IN},
+    {"NotShowIn", DesktopKey::NOT_SHOW_IN},
+    {"Categories", DesktopKey::CATEGORIES},
+    {"TryExec", DesktopKey::TRY_EXEC},
+}};
+
+inline constexpr size_t TABLE_SIZE = 32;
+
+constexpr uint32_t hash(std::string_view key, uint32_t seed) {
+    uint32_t h = seed ^ static_cast<uint32_t>(key.size());
+    for (char c : key) {
+        h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return (h ^ (h >> 15)) & (TABLE_SIZE - 1);
+}
+
+// Smallest seed for which every known key lands in its own slot
+constexpr uint32_t findSeed() {
+    for (uint32_t seed = 1; seed < 100000; ++seed) {
+        bool used[TABLE_SIZE] = {};
+        bool ok = true;
+        for (const auto& known : KNOWN) {
+            uint32_t slot = hash(known.name, seed);
+            if (used[slot]) {
+                ok = false;
+                break;
+            }
+            used[slot] = true;
+        }
+        if (ok) return seed;
+    }
+    return 0;
+}
+
+inline constexpr uint32_t SEED = findSeed();
+static_assert(SEED != 0, "no collision-free seed for the desktop key table");
+
+constexpr std::array<KeyName, TABLE_SIZE> buildTable() {
+    std::array<KeyName, TABLE_SIZE> table{};
+    for (const auto& known : KNOWN) {
+        table[hash(known.name, SEED)] = known;
+    }
+    return table;
+}
+
+inline constexpr std::array<KeyName, TABLE_SIZE> TABLE = buildTable();
+
+// One hash and one compare; localized keys such as "Name[de]" miss by design
+constexpr DesktopKey lookup(std::string_view key) {
+    const auto& slot = TABLE[hash(key, SEED)];
+    return slot.name == key ? slot.key : DesktopKey::UNKNOWN;
+}
+
+} // namespace DesktopKeys
+
+// Allocation-light .desktop parser.
+//
+// The file is bulk-read into a per-thread buffer and tokenized in place by
+// DesktopEntryLines; only the values of keys we keep are copied into
+// DesktopApp. Parsing stops at the first group header after [Desktop Entry].
+//
+// Loading can be split in two: parseListFields() keeps only what the list
+// needs to render (name, icon, visibility) and parseDetails() later fills in
+// the rest, starting at the recorded [Desktop Entry] offset.
+class DesktopEntryParser {
+  public:
+    enum class Fields : uint8_t {
+        ALL,
+        // Name, Icon, the other searched fields and the visibility keys
+        // (TryExec included); Exec is only checked for presence
+        LIST,
+        // Everything LIST leaves out
+        DETAILS,
+    };
+
+    // Entries are returned even when hidden; nullopt means unreadable
+    static std::optional<DesktopApp> parseFile(const fs::path& filepath);
+    static std::optional<DesktopApp> parseListFields(const fs::path& filepath);
+
+    // Complete an entry returned by parseListFields(). Returns false if the
+    // file can no longer be read.
+    static bool parseDetails(const fs::path& filepath, DesktopApp& app);
+
+    static void parseBuffer(std::string_view data, DesktopApp& app, Fields fields = Fields::ALL);
+};
+
+#endif // DESKTOP_ENTRY_PARSER_HPP
@@ -0,0 +1,138 @@
+#include "PathIndex.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+PathIndex::~PathIndex() {
+    if (m_watchFd >= 0) {
+        ::close(m_watchFd);
+    }
+}
+
+std::vector<fs::path> PathIndex::searchPath() {
+    std::vector<fs::path> dirs;
+
+    const char* env = std::getenv("PATH");
+    std::string_view list = env ? env : "/usr/local/bin:/usr/bin:/bin";
+
+    while (!list.empty()) {
+        size_t sep = list.find(':');
+        std::string_view entry = list.substr(0, sep);
+        list = sep == std::string_view::npos ? std::string_view{} : list.substr(sep + 1);
+
+        // Relative entries depend on the working directory; skip them
+        if (entry.empty() || entry.front() != '/') continue;
+
+        fs::path dir = fs::path(entry).lexically_normal();
+        if (std::find(dirs.begin(), dirs.end(), dir) == dirs.end()) {
+            dirs.push_back(std::move(dir));
+        }
+    }
+
+    return dirs;
+}
+
+void PathIndex::build(const std::vector<fs::path>& directories) {
+    m_directories = directories.empty() ? searchPath() : directories;
+
+    // Collect offsets first; views are only taken once the arena stops growing
+    std::vector<std::pair<uint32_t, uint32_t>> spans;
+    m_arena.clear();
+    for (const auto& dir : m_directories) {
+        readDirectory(dir, spans);
+    }
+
+    m_names.clear();
+    m_names.reserve(spans.size());
+    for (const auto& [offset, length] : spans) {
+        m_names.emplace_back(m_arena.data() + offset, length);
+    }
+
+    std::sort(m_names.begin(), m_names.end());
+    m_names.erase(std::unique(m_names.begin(), m_names.end()), m_names.end());
+}
+
+void PathIndex::readDirectory(const fs::path& directory,
+                              std::vector<std::pair<uint32_t, uint32_t>>& spans) {
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return;
+
+    alignas(dirent64) char buffer[32 << 10];
+    for (;;) {
+        ssize_t len = ::getdents64(fd, buffer, sizeof(buffer));
+        if (len <= 0) break;
+
+        for (ssize_t offset = 0; offset < len;) {
+            const auto* entry = reinterpret_cast<const dirent64*>(buffer + offset);
+            offset += entry->d_reclen;
+
+            // Dotfiles are never commands anyone types; this also drops . and ..
+            if (entry->d_type == DT_DIR || entry->d_name[0] == '.') continue;
+
+            std::string_view name = entry->d_name;
+            spans.emplace_back(static_cast<uint32_t>(m_arena.size()), static_cast<uint32_t>(name.size()));
+            m_arena.append(name);
+        }
+    }
+
+    ::close(fd);
+}
+
+bool PathIndex::contains(std::string_view name) const {
+    return std::binary_search(m_names.begin(), m_names.end(), name);
+}
+
+bool PathIndex::canExecute(std::string_view program) const {
+    if (program.find('/') != std::string_view::npos) {
+        return ::access(std::string(program).c_str(), X_OK) == 0;
+    }
+    return contains(program);
+}
+
+void PathIndex::complete(std::string_view prefix, size_t limit,
+                         std::vector<std::string_view>& out) const {
+    out.clear();
+    for (auto it = std::lower_bound(m_names.begin(), m_names.end(), prefix);
+         it != m_names.end() && out.size() < limit && it->starts_with(prefix); ++it) {
+        out.push_back(*it);
+    }
+}
+
+void PathIndex::watch() {
+    if (m_watchFd >= 0) return;
+
+    m_watchFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_watchFd < 0) {
+        std::cerr << "Warning: inotify unavailable, PATH changes need a restart" << std::endl;
+        return;
+    }
+
+    constexpr uint32_t MASK = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+    for (const auto& dir : m_directories) {
+        ::inotify_add_watch(m_watchFd, dir.c_str(), MASK);
+    }
+}
+
+bool PathIndex::readWatchEvents() {
+    if (m_watchFd < 0) return false;
+
+    // Any event means a rebuild, so the events themselves need no decoding
+    alignas(inotify_event) char buffer[4096];
+    while (::read(m_watchFd, buffer, sizeof(buffer)) > 0) {
+        m_pendingRebuild = true;
+    }
+    return m_pendingRebuild;
+}
+
+bool PathIndex::applyPendingChanges() {
+    if (!m_pendingRebuild) return false;
+    m_pendingRebuild = false;
+
+    std::vector<std::string> previous(m_names.begin(), m_names.end());
+    build(m_directories);
+    return !std::equal(previous.begin(), previous.end(), m_names.begin(), m_names.end());
+}
@@ -0,0 +1,65 @@
+#ifndef PATH_INDEX_HPP
+#define PATH_INDEX_HPP
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// Sorted set of the command names reachable through $PATH.
+//
+// Each directory is read with bulk getdents64() calls and no per-file stat:
+// PATH directories hold executables by convention, and checking mode bits
+// would cost exactly the stat per file this index exists to avoid. Names
+// live in one arena and are kept as sorted views, so membership is a binary
+// search and prefix completion is a range scan.
+class PathIndex {
+  public:
+    PathIndex() = default;
+    ~PathIndex();
+
+    PathIndex(const PathIndex&) = delete;
+    PathIndex& operator=(const PathIndex&) = delete;
+
+    // Absolute entries of $PATH in order, without duplicates
+    static std::vector<fs::path> searchPath();
+
+    // (Re)read `directories`; empty means searchPath()
+    void build(const std::vector<fs::path>& directories = {});
+
+    size_t size() const { return m_names.size(); }
+    bool contains(std::string_view name) const;
+
+    // TryExec semantics: absolute paths are checked with access(X_OK), bare
+    // names are looked up in the index
+    bool canExecute(std::string_view program) const;
+
+    // Fill `out` with up to `limit` names starting with `prefix`, in order.
+    // The views stay valid until the next build().
+    void complete(std::string_view prefix, size_t limit, std::vector<std::string_view>& out) const;
+
+    // Watch the indexed directories so installs and removals are noticed
+    void watch();
+    int watchFd() const { return m_watchFd; }
+
+    // Drain queued inotify events; returns true if a rebuild is pending
+    bool readWatchEvents();
+
+    // Rebuild if events arrived. Returns true if the set of names changed.
+    bool applyPendingChanges();
+
+  private:
+    void readDirectory(const fs::path& directory, std::vector<std::pair<uint32_t, uint32_t>>& spans);
+
+    std::vector<fs::path> m_directories;
+    std::string m_arena;
+    std::vector<std::string_view> m_names;
+
+    int m_watchFd = -1;
+    bool m_pendingRebuild = false;
+};
+
+#endif // PATH_INDEX_HPP
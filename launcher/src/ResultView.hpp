@@ -0,0 +1,149 @@
+#ifndef RESULT_VIEW_HPP
+#define RESULT_VIEW_HPP
+
+#include "AppStore.hpp"
+#include "VirtualGrid.hpp"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// The items showing a result list, virtualized by a VirtualGrid: only the
+// results near the viewport have items, and scrolling rebinds them. A new
+// result list is reconciled against the items in place by AppStore::version(),
+// so an app that stays in the window keeps its item and only the difference
+// churns, and an ID reused for another app since the items were built is not
+// mistaken for the app they show.
+//
+// Building and placing elements is left to a Host, so the view-update path
+// runs the same against hyprtoolkit and against the stand-in backend of
+// bench/bench_keystrokes.cpp. A Host provides:
+//
+//   using ItemPtr = ...;                          // shared handle to an item
+//   uint32_t version(AppStore::AppId id);         // AppStore::version()
+//   ItemPtr makeItem(size_t index, AppStore::AppId id);  // null on failure
+//   void bindItem(const ItemPtr& item, size_t index, AppStore::AppId id);
+//   // Size the container for `count` results, so the scrollbar covers all
+//   // of them, and say how they are laid out. Items placed by an earlier
+//   // update stay in it until removed.
+//   GridGeometry beginLayout(size_t count);
+//   void placeItem(const ItemPtr& item, size_t index);  // into the container
+//   void moveItem(const ItemPtr& item, size_t index);   // within it
+//   void removeItem(const ItemPtr& item);               // out of it
+//
+// Items need setActive(bool) and getVersion(), the version of their app. Every update is counted along
+// with what it did to the items, in total and for the last one alone.
+template <typename Host>
+class ResultView {
+  public:
+    using ItemPtr = typename Host::ItemPtr;
+
+    static constexpr size_t NONE = SIZE_MAX;
+
+    struct Stats {
+        uint64_t updates = 0;
+        // Items created, rebound to another app, and removed from the
+        // container: the churn
+        uint64_t built = 0;
+        uint64_t rebound = 0;
+        uint64_t released = 0;
+        // Items left showing their app, moved to another index or not
+        uint64_t moved = 0;
+        uint64_t kept = 0;
+        uint64_t destroyed = 0;
+
+        uint64_t churn() const { return built + rebound + released; }
+    };
+
+    explicit ResultView(Host& host) : m_host(host) {}
+
+    // Show `apps`, scrolled to the top of a viewport `height` tall, with
+    // nothing active
+    void show(std::span<const AppStore::AppId> apps, float height) {
+        const Stats before = stats();
+        ++m_updates;
+        setActive(NONE);
+        m_apps.assign(apps.begin(), apps.end());
+        m_versions.resize(m_apps.size());
+        for (size_t i = 0; i < m_apps.size(); ++i) m_versions[i] = m_host.version(m_apps[i]);
+        const GridGeometry geometry = m_host.beginLayout(m_apps.size());
+        m_grid.reconcile(m_apps.size(), geometry, 0, height);
+        m_lastUpdate = since(before);
+    }
+
+    // Follow the scroll area to `offset`, `height` tall
+    void setViewport(float offset, float height) {
+        if (!m_apps.empty()) m_grid.setViewport(offset, height);
+    }
+
+    // Drop every item; the host clears whatever holds their elements
+    void clear() {
+        m_grid.clear();
+        m_apps.clear();
+        m_versions.clear();
+        m_active = NONE;
+    }
+
+    // Highlight the result at `index`, or none
+    void setActive(size_t index) {
+        if (ItemPtr old = item(m_active)) old->setActive(false);
+        m_active = index < m_apps.size() ? index : NONE;
+        if (ItemPtr now = item(m_active)) now->setActive(true);
+    }
+    size_t active() const { return m_active; }
+
+    size_t size() const { return m_apps.size(); }
+    bool empty() const { return m_apps.empty(); }
+    AppStore::AppId appId(size_t index) const { return m_apps[index]; }
+    // Version of the app shown at `index`, as of show()
+    uint32_t version(size_t index) const { return m_versions[index]; }
+    // The item showing result `index`, null while it is outside the window
+    ItemPtr item(size_t index) const { return m_grid.cell(index); }
+    // Items placed in the container, and pooled for reuse
+    size_t materialized() const { return m_grid.materialized(); }
+    size_t pooled() const { return m_grid.pooled(); }
+
+    Stats stats() const {
+        const auto& grid = m_grid.stats();
+        return {m_updates, grid.built, grid.rebound, grid.released, grid.moved, grid.kept, grid.destroyed};
+    }
+    // What the last show() did
+    const Stats& lastUpdate() const { return m_lastUpdate; }
+
+  private:
+    // Hands the grid's cells to the Host as items of m_apps
+    struct Cells {
+        using CellPtr = ItemPtr;
+
+        ResultView& view;
+
+        ItemPtr makeCell(size_t index) { return view.m_host.makeItem(index, view.m_apps[index]); }
+        void bindCell(const ItemPtr& item, size_t index) { view.m_host.bindItem(item, index, view.m_apps[index]); }
+        void placeCell(const ItemPtr& item, size_t index) {
+            view.m_host.placeItem(item, index);
+            item->setActive(index == view.m_active);
+        }
+        void moveCell(const ItemPtr& item, size_t index) { view.m_host.moveItem(item, index); }
+        void removeCell(const ItemPtr& item) { view.m_host.removeItem(item); }
+        uint32_t cellKey(const ItemPtr& item) const { return item->getVersion(); }
+        uint32_t itemKey(size_t index) const { return view.m_versions[index]; }
+    };
+
+    Stats since(const Stats& before) const {
+        const Stats now = stats();
+        return {now.updates - before.updates, now.built - before.built,     now.rebound - before.rebound,
+                now.released - before.released, now.moved - before.moved, now.kept - before.kept,
+                now.destroyed - before.destroyed};
+    }
+
+    Host& m_host;
+    std::vector<AppStore::AppId> m_apps;
+    std::vector<uint32_t> m_versions;
+    size_t m_active = NONE;
+    uint64_t m_updates = 0;
+    Stats m_lastUpdate;
+
+    Cells m_cells{*this};
+    VirtualGrid<Cells> m_grid{m_cells};
+};
+
+#endif // RESULT_VIEW_HPP
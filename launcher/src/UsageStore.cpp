@@ -0,0 +1,239 @@
+#include "UsageStore.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char MAGIC[8] = {'L', 'A', 'U', 'N', 'U', 'S', 'E', 'D'};
+
+// Records in a new store; doubled whenever it is three quarters full
+constexpr uint32_t INITIAL_CAPACITY = 256;
+
+uint64_t fnv1a(std::string_view data) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (char c : data) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    // 0 marks an empty record
+    return hash ? hash : 1;
+}
+
+} // namespace
+
+struct UsageStore::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t reserved[3];
+};
+
+struct UsageStore::Record {
+    // fnv1a of the desktop-file ID, or 0 if the record is empty
+    uint64_t key;
+    // Decayed launch count as of `updated`
+    double score;
+    int64_t updated;
+    uint32_t launches;
+    uint32_t reserved;
+};
+
+UsageStore::~UsageStore() {
+    unmap();
+}
+
+fs::path UsageStore::defaultPath() {
+    const char* stateHome = std::getenv("XDG_STATE_HOME");
+    if (stateHome && stateHome[0] == '/') {
+        return fs::path(stateHome) / "launcher" / "usage.bin";
+    }
+
+    const char* home = std::getenv("HOME");
+    if (!home) return {};
+    return fs::path(home) / ".local" / "state" / "launcher" / "usage.bin";
+}
+
+int64_t UsageStore::now() {
+    return static_cast<int64_t>(std::time(nullptr));
+}
+
+bool UsageStore::open(const fs::path& path) {
+    unmap();
+    m_path = path;
+    if (path.empty()) return false;
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* map = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) return false;
+
+    const auto* head = static_cast<const Header*>(map);
+    const uint32_t capacity = head->capacity;
+    bool valid = std::memcmp(head->magic, MAGIC, sizeof(MAGIC)) == 0 && head->version == VERSION &&
+                 capacity != 0 && (capacity & (capacity - 1)) == 0 && head->used < capacity &&
+                 static_cast<size_t>(st.st_size) == sizeof(Header) + size_t{capacity} * sizeof(Record);
+
+    // Probes stop at an empty record, so `used` has to be what the records
+    // say, and below the capacity
+    if (valid) {
+        const auto* first = reinterpret_cast<const Record*>(static_cast<const char*>(map) + sizeof(Header));
+        const auto live = std::count_if(first, first + capacity, [](const Record& record) { return record.key != 0; });
+        valid = static_cast<size_t>(live) == head->used;
+    }
+    if (!valid) {
+        ::munmap(map, st.st_size);
+        return false;
+    }
+
+    m_data = static_cast<char*>(map);
+    m_size = st.st_size;
+    m_capacity = capacity;
+    return true;
+}
+
+size_t UsageStore::size() const {
+    return m_data ? header()->used : 0;
+}
+
+double UsageStore::frecency(std::string_view desktopId, int64_t now) const {
+    if (!m_data) return 0;
+
+    const uint64_t key = fnv1a(desktopId);
+    const Record* record = slot(key);
+    if (!record || record->key != key) return 0;
+
+    const double age = static_cast<double>(std::max<int64_t>(now - record->updated, 0));
+    return record->score * std::exp2(-age / HALF_LIFE_SECONDS);
+}
+
+bool UsageStore::recordLaunch(std::string_view desktopId, int64_t now) {
+    if (!m_data && !rebuild(INITIAL_CAPACITY)) return false;
+
+    const uint64_t key = fnv1a(desktopId);
+    Record* record = slot(key);
+
+    if (!record || record->key != key) {
+        // Keep a quarter of the table empty so probe runs stay short
+        if (!record || (header()->used + 1) * 4 > m_capacity * 3) {
+            if (!rebuild(m_capacity * 2)) return false;
+            record = slot(key);
+        }
+        *record = Record{key, 0, now, 0, 0};
+        ++header()->used;
+    }
+
+    const double age = static_cast<double>(std::max<int64_t>(now - record->updated, 0));
+    record->score = record->score * std::exp2(-age / HALF_LIFE_SECONDS) + 1;
+    record->updated = std::max(record->updated, now);
+    ++record->launches;
+    return true;
+}
+
+bool UsageStore::rebuild(uint32_t capacity) {
+    if (m_path.empty()) return false;
+
+    // Written beside the store and renamed over it, so another launcher
+    // still mapping the old file never sees it change size under it
+    std::error_code ec;
+    fs::create_directories(m_path.parent_path(), ec);
+    const fs::path tmpPath = m_path.string() + ".tmp";
+
+    int fd = ::open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "Warning: Cannot create usage store " << tmpPath << std::endl;
+        return false;
+    }
+
+    const size_t size = sizeof(Header) + size_t{capacity} * sizeof(Record);
+    void* map = ::ftruncate(fd, static_cast<off_t>(size)) == 0
+                    ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                    : MAP_FAILED;
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        std::cerr << "Warning: Cannot map usage store " << tmpPath << std::endl;
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+
+    // The current table stays mapped until the new one has replaced it,
+    // so a failed rename loses nothing
+    auto* head = static_cast<Header*>(map);
+    auto* table = reinterpret_cast<Record*>(static_cast<char*>(map) + sizeof(Header));
+    std::memcpy(head->magic, MAGIC, sizeof(MAGIC));
+    head->version = VERSION;
+    head->capacity = capacity;
+    head->used = 0;
+    for (uint32_t i = 0; m_data && i < m_capacity; ++i) {
+        const Record& record = records()[i];
+        if (record.key == 0) continue;
+        Record* target = probe(table, capacity, record.key);
+        if (!target) break;
+        if (target->key == 0) ++head->used;
+        *target = record;
+    }
+
+    if (::rename(tmpPath.c_str(), m_path.c_str()) != 0) {
+        std::cerr << "Warning: Cannot replace usage store " << m_path << std::endl;
+        ::munmap(map, size);
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+
+    unmap();
+    m_data = static_cast<char*>(map);
+    m_size = size;
+    m_capacity = capacity;
+    return true;
+}
+
+void UsageStore::unmap() {
+    if (m_data) {
+        ::munmap(m_data, m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_capacity = 0;
+}
+
+UsageStore::Header* UsageStore::header() const {
+    static_assert(sizeof(Header) == 32 && sizeof(Record) == 32, "the file layout must not depend on the compiler");
+    return reinterpret_cast<Header*>(m_data);
+}
+
+UsageStore::Record* UsageStore::records() const {
+    return reinterpret_cast<Record*>(m_data + sizeof(Header));
+}
+
+UsageStore::Record* UsageStore::slot(uint64_t key) const {
+    return probe(records(), m_capacity, key);
+}
+
+UsageStore::Record* UsageStore::probe(Record* records, uint32_t capacity, uint64_t key) {
+    // Linear probing, at most once around: the file is shared, so another
+    // process may have filled the table since it was checked
+    const uint32_t mask = capacity - 1;
+    uint32_t i = static_cast<uint32_t>(key) & mask;
+    for (uint32_t step = 0; step < capacity; ++step, i = (i + 1) & mask) {
+        Record* record = records + i;
+        if (record->key == key || record->key == 0) return record;
+    }
+    return nullptr;
+}
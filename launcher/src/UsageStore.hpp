@@ -0,0 +1,75 @@
+#ifndef USAGE_STORE_HPP
+#define USAGE_STORE_HPP
+
+#include <cstdint>
+#include <string_view>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// Launch history per desktop-file ID, kept as frecency: a launch count that
+// decays exponentially with HALF_LIFE_SECONDS, so apps used often and
+// recently score highest and an app not used for a while fades out.
+//
+// The file is a small header followed by fixed-size records in an
+// open-addressed table keyed by a hash of the ID. It is mmap'd shared and
+// updated in place, so a lookup or a launch touches one or two records and
+// costs no read or write call. Each record stores its score as of its last
+// launch; decay to the present is applied when it is read. The file is only
+// created by the first launch, and a foreign or damaged one is started over.
+class UsageStore {
+  public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr int64_t HALF_LIFE_SECONDS = 7 * 24 * 60 * 60;
+
+    UsageStore() = default;
+    ~UsageStore();
+
+    UsageStore(const UsageStore&) = delete;
+    UsageStore& operator=(const UsageStore&) = delete;
+
+    // $XDG_STATE_HOME/launcher/usage.bin (or ~/.local/state/launcher/usage.bin)
+    static fs::path defaultPath();
+
+    // Seconds since the epoch, the clock frecency is measured in
+    static int64_t now();
+
+    // Map the store at `path` if it exists. Returns false if it is missing
+    // or unusable; recordLaunch() creates it either way.
+    bool open(const fs::path& path);
+
+    // Number of IDs with a launch recorded
+    size_t size() const;
+
+    // Decayed launch count of `desktopId` at `now`; 0 if never launched
+    double frecency(std::string_view desktopId, int64_t now) const;
+
+    // Count one launch of `desktopId` at `now`. Returns false if the store
+    // could not be created or grown.
+    bool recordLaunch(std::string_view desktopId, int64_t now);
+
+  private:
+    struct Header;
+    struct Record;
+
+    // Replace the file with an empty table of `capacity` records holding
+    // whatever the current one has
+    bool rebuild(uint32_t capacity);
+    void unmap();
+
+    Header* header() const;
+    Record* records() const;
+    // The record holding `key`, else the empty slot it would go in, else
+    // null if the table has neither
+    Record* slot(uint64_t key) const;
+    static Record* probe(Record* records, uint32_t capacity, uint64_t key);
+
+    fs::path m_path;
+    char* m_data = nullptr;
+    size_t m_size = 0;
+    // Copied from the header when mapped, so a damaged header cannot
+    // send probes past the mapping
+    uint32_t m_capacity = 0;
+};
+
+#endif // USAGE_STORE_HPP
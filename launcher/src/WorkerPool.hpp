@@ -0,0 +1,63 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool for fork/join batches such as parsing the desktop corpus.
+//
+// forEach() hands out [0, count) in chunks of `grain` items; every worker
+// claims chunks from a shared counter until none are left. The calling thread
+// acts as worker 0, so a pool of size 1 runs the batch inline with no threads.
+class WorkerPool {
+  public:
+    explicit WorkerPool(size_t threads = 0)
+        : m_size(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+    }
+
+    size_t size() const { return m_size; }
+
+    // Number of workers a batch of `count` items will actually use
+    size_t workersFor(size_t count, size_t grain) const {
+        size_t chunks = (count + grain - 1) / std::max<size_t>(grain, 1);
+        return std::max<size_t>(1, std::min(m_size, chunks));
+    }
+
+    // fn(workerIndex, itemIndex) is called once per item
+    template <typename Fn>
+    void forEach(size_t count, size_t grain, Fn&& fn) const {
+        if (count == 0) return;
+        grain = std::max<size_t>(grain, 1);
+
+        std::atomic<size_t> next{0};
+        auto work = [&](size_t worker) {
+            for (;;) {
+                size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+                if (begin >= count) break;
+                size_t end = std::min(begin + grain, count);
+                for (size_t i = begin; i < end; ++i) {
+                    fn(worker, i);
+                }
+            }
+        };
+
+        size_t workers = workersFor(count, grain);
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (size_t w = 1; w < workers; ++w) {
+            threads.emplace_back(work, w);
+        }
+        work(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+  private:
+    size_t m_size;
+};
+
+#endif // WORKER_POOL_HPP
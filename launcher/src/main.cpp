@@ -1,4 +1,8 @@
 #include "ConfigManager.hpp"
+#include "AppDatabase.hpp"
+#include "AppSearch.hpp"
+#include "ResultView.hpp"
+#include "SearchWorker.hpp"
 #include <hyprtoolkit/core/Backend.hpp>
 #include <hyprtoolkit/window/Window.hpp>
 #include <hyprtoolkit/element/Rectangle.hpp>
@@ -21,6 +25,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <memory>
+#include <chrono>
 
 namespace fs = std::filesystem;
 
@@ -31,145 +36,21 @@ using namespace Hyprtoolkit;
 // Simplified Data Structures
 // ============================================
 
-struct DesktopApp {
-    std::string name;
-    std::string exec;
-    std::string icon;
-    std::string desktopFile;
-    bool noDisplay = false;
-    bool hidden = false;
-    
-    bool operator<(const DesktopApp& other) const {
-        return name < other.name;
-    }
-};
-
 enum class ViewMode {
     LIST,
     GRID
 };
 
-// ============================================
-// Simplified AppDatabase
-// ============================================
-
-class AppDatabase {
-  public:
-    AppDatabase() {
-        loadApps();
-    }
-    
-    const std::vector<DesktopApp>& getAllApps() const { return m_allApps; }
-    
-    std::vector<DesktopApp> filterApps(const std::string& query) const {
-        if (query.empty()) {
-            return m_allApps;
-        }
-        
-        std::string lowerQuery = query;
-        std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), ::tolower);
-        
-        std::vector<DesktopApp> filtered;
-        for (const auto& app : m_allApps) {
-            std::string lowerName = app.name;
-            std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
-            
-            if (lowerName.find(lowerQuery) != std::string::npos) {
-                filtered.push_back(app);
-            }
-        }
-        return filtered;
-    }
-    
-  private:
-    void loadApps() {
-        std::vector<fs::path> desktopDirs = {
-            "/usr/share/applications",
-            fs::path(std::getenv("HOME")) / ".local/share/applications"
-        };
-        
-        for (const auto& dir : desktopDirs) {
-            if (fs::exists(dir)) {
-                loadAppsFromDirectory(dir);
-            }
-        }
-        
-        std::sort(m_allApps.begin(), m_allApps.end());
-    }
-    
-    void loadAppsFromDirectory(const fs::path& directory) {
-        for (const auto& entry : fs::directory_iterator(directory)) {
-            if (entry.path().extension() == ".desktop") {
-                parseDesktopFile(entry.path());
-            }
-        }
-    }
-    
-    void parseDesktopFile(const fs::path& filepath) {
-        std::ifstream file(filepath);
-        if (!file.is_open()) return;
-        
-        DesktopApp app;
-        app.desktopFile = filepath.string();
-        
-        std::string line;
-        bool inDesktopEntry = false;
-        
-        while (std::getline(file, line)) {
-            if (line.find('#') != std::string::npos) {
-                line = line.substr(0, line.find('#'));
-            }
-            
-            line.erase(0, line.find_first_not_of(" \t"));
-            line.erase(line.find_last_not_of(" \t") + 1);
-            
-            if (line.empty()) continue;
-            
-            if (line == "[Desktop Entry]") {
-                inDesktopEntry = true;
-                continue;
-            } else if (line[0] == '[') {
-                inDesktopEntry = false;
-                continue;
-            }
-            
-            if (!inDesktopEntry) continue;
-            
-            size_t equalsPos = line.find('=');
-            if (equalsPos == std::string::npos) continue;
-            
-            std::string key = line.substr(0, equalsPos);
-            std::string value = line.substr(equalsPos + 1);
-            
-            if (key == "Name") {
-                app.name = value;
-            } else if (key == "Exec") {
-                app.exec = value;
-            } else if (key == "Icon") {
-                app.icon = value;
-            } else if (key == "NoDisplay") {
-                app.noDisplay = (value == "true");
-            } else if (key == "Hidden") {
-                app.hidden = (value == "true");
-            }
-        }
-        
-        if (!app.name.empty() && !app.exec.empty() && !app.noDisplay && !app.hidden) {
-            m_allApps.push_back(app);
-        }
-    }
-    
-    std::vector<DesktopApp> m_allApps;
-};
-
 // ============================================
 // Base AppItem Class
 // ============================================
 
 class BaseAppItem {
   public:
-    BaseAppItem(const DesktopApp& app, CSharedPointer<IBackend> backend)
-        : m_app(app), m_backend(backend) {
+    BaseAppItem(const AppStore& store, size_t index, AppStore::AppId appId, CSharedPointer<IBackend> backend,
+                std::function<void(size_t)> onHover, std::function<void(size_t)> onClick)
+        : m_store(store), m_index(index), m_appId(appId), m_version(store.version(appId)), m_backend(backend),
+          m_onHover(std::move(onHover)), m_onClick(std::move(onClick)) {
     }
     
     virtual ~BaseAppItem() = default;
@@ -178,17 +59,24 @@ class BaseAppItem {
     virtual void setActive(bool active) = 0;
     virtual bool isActive() const = 0;
     virtual void updateAppearance() = 0;
+    // Show result `index`, app `appId`, reusing the elements
+    virtual void bind(size_t index, AppStore::AppId appId) = 0;
     
-    const DesktopApp& getApp() const { return m_app; }
+    size_t getIndex() const { return m_index; }
+    AppStore::AppId getAppId() const { return m_appId; }
+    uint32_t getVersion() const { return m_version; }
     
-    void launch() const {
-        std::string cleanCmd = cleanExecCommand(m_app.exec);
+    static void launch(const AppStore& store, AppStore::AppId appId) {
+        // The entry may have been uninstalled while the view was open
+        if (!store.contains(appId)) return;
+        
+        std::string cleanCmd = cleanExecCommand(std::string(store.exec(appId)));
         std::string fullCmd = cleanCmd + " &";
         std::system(fullCmd.c_str());
     }
 
   private:
-    std::string cleanExecCommand(const std::string& exec) const {
+    static std::string cleanExecCommand(const std::string& exec) {
         std::string result = exec;
         size_t pos = 0;
         while ((pos = result.find('%', pos)) != std::string::npos) {
@@ -202,19 +90,27 @@ class BaseAppItem {
     }
 
   protected:
-    DesktopApp m_app;
+    const AppStore& m_store;
+    size_t m_index;
+    AppStore::AppId m_appId;
+    uint32_t m_version;
     CSharedPointer<IBackend> m_backend;
     bool m_active = false;
     
+    // Called with the index of the result the item shows at the time
+    std::function<void(size_t)> m_onHover;
+    std::function<void(size_t)> m_onClick;
+    
     std::string findIconPath() {
-        if (m_app.icon.empty()) return "";
+        const std::string icon(m_store.icon(m_appId));
+        if (icon.empty()) return "";
         
-        if (fs::path(m_app.icon).is_absolute()) {
-            if (fs::exists(m_app.icon)) return m_app.icon;
+        if (fs::path(icon).is_absolute()) {
+            if (fs::exists(icon)) return icon;
         }
         
-        fs::path desktopDir = fs::path(m_app.desktopFile).parent_path();
-        fs::path localPath = desktopDir / m_app.icon;
+        fs::path desktopDir = fs::path(m_store.desktopFile(m_appId)).parent_path();
+        fs::path localPath = desktopDir / icon;
         if (fs::exists(localPath)) return localPath.string();
         
         std::vector<std::string> extensions = {".png", ".svg", ".jpg", ".jpeg", ".xpm", ""};
@@ -234,7 +130,7 @@ class BaseAppItem {
         for (const auto& dir : iconDirs) {
             if (fs::exists(dir)) {
                 for (const auto& ext : extensions) {
-                    fs::path checkPath = dir / (m_app.icon + ext);
+                    fs::path checkPath = dir / (icon + ext);
                     if (fs::exists(checkPath)) return checkPath.string();
                 }
             }
@@ -244,11 +140,12 @@ class BaseAppItem {
     }
 
     CSharedPointer<IElement> createIconElement(float size) {
-        if (m_app.icon.empty()) return createPlaceholder(size);
+        const std::string icon(m_store.icon(m_appId));
+        if (icon.empty()) return createPlaceholder(size);
         
         auto icons = m_backend->systemIcons();
         if (icons) {
-            auto iconHandle = icons->lookupIcon(m_app.icon);
+            auto iconHandle = icons->lookupIcon(icon);
             if (iconHandle && iconHandle->exists()) {
                 return CImageBuilder::begin()
                     ->icon(iconHandle)
@@ -327,10 +224,10 @@ class BaseAppItem {
 
 class ListAppItem : public BaseAppItem {
   public:
-    ListAppItem(const DesktopApp& app, CSharedPointer<IBackend> backend, 
-                std::function<void()> onHover = nullptr, 
-                std::function<void()> onClick = nullptr)
-        : BaseAppItem(app, backend), m_onHover(onHover), m_onClick(onClick) {
+    ListAppItem(const AppStore& store, size_t index, AppStore::AppId appId, CSharedPointer<IBackend> backend,
+                std::function<void(size_t)> onHover = nullptr,
+                std::function<void(size_t)> onClick = nullptr)
+        : BaseAppItem(store, index, appId, backend, std::move(onHover), std::move(onClick)) {
         createUI();
     }
     
@@ -344,6 +241,22 @@ class ListAppItem : public BaseAppItem {
     
     bool isActive() const override { return m_active; }
     
+    void bind(size_t index, AppStore::AppId appId) override {
+        m_index = index;
+        const uint32_t version = m_store.version(appId);
+        if ((appId == m_appId && version == m_version) || !m_rowLayout || !m_text) return;
+        m_appId = appId;
+        m_version = version;
+        
+        m_text->rebuild()->text(std::string{m_store.name(m_appId)})->commence();
+        
+        // Children can only be appended, and the icon comes first
+        m_rowLayout->clearChildren();
+        m_iconElement = createIconElement(32.0F);
+        m_rowLayout->addChild(m_iconElement);
+        m_rowLayout->addChild(m_text);
+    }
+    
     void updateAppearance() override {
         if (!m_background || !m_text) return;
         
@@ -407,7 +320,7 @@ class ListAppItem : public BaseAppItem {
         m_rowLayout->addChild(m_iconElement);
 
         m_text = CTextBuilder::begin()
-            ->text(std::string{m_app.name})
+            ->text(std::string{m_store.name(m_appId)})
             ->color([palette] { 
                 if (!palette) return CHyprColor(0.8, 0.8, 0.8, 1);
                 return palette->m_colors.text;
@@ -428,7 +341,7 @@ class ListAppItem : public BaseAppItem {
         // Hover enter
         m_background->setMouseEnter([this](const Hyprutils::Math::Vector2D&) {
             if (m_onHover) {
-                m_onHover();
+                m_onHover(m_index);
             }
         });
         
@@ -441,7 +354,7 @@ class ListAppItem : public BaseAppItem {
         m_background->setMouseButton([this](Input::eMouseButton button, bool down) {
             if (button == Input::MOUSE_BUTTON_LEFT && down) {
                 if (m_onClick) {
-                    m_onClick();
+                    m_onClick(m_index);
                 }
             }
         });
@@ -451,9 +364,6 @@ class ListAppItem : public BaseAppItem {
     CSharedPointer<CRowLayoutElement> m_rowLayout;
     CSharedPointer<CTextElement> m_text;
     CSharedPointer<IElement> m_iconElement;
-    
-    std::function<void()> m_onHover;
-    std::function<void()> m_onClick;
 };
 
 // ============================================
@@ -462,10 +372,10 @@ class ListAppItem : public BaseAppItem {
 
 class GridAppItem : public BaseAppItem {
   public:
-    GridAppItem(const DesktopApp& app, CSharedPointer<IBackend> backend,
-                std::function<void()> onHover = nullptr,
-                std::function<void()> onClick = nullptr)
-        : BaseAppItem(app, backend), m_onHover(onHover), m_onClick(onClick) {
+    GridAppItem(const AppStore& store, size_t index, AppStore::AppId appId, CSharedPointer<IBackend> backend,
+                std::function<void(size_t)> onHover = nullptr,
+                std::function<void(size_t)> onClick = nullptr)
+        : BaseAppItem(store, index, appId, backend, std::move(onHover), std::move(onClick)) {
         createUI();
     }
     
@@ -479,6 +389,23 @@ class GridAppItem : public BaseAppItem {
     
     bool isActive() const override { return m_active; }
     
+    void bind(size_t index, AppStore::AppId appId) override {
+        m_index = index;
+        const uint32_t version = m_store.version(appId);
+        if ((appId == m_appId && version == m_version) || !m_iconContainer || !m_text) return;
+        m_appId = appId;
+        m_version = version;
+        
+        m_text->rebuild()->text(std::string{m_store.name(m_appId)})->commence();
+        
+        // Children can only be appended, so the spacers go back around the new icon
+        m_iconContainer->clearChildren();
+        m_iconElement = createIconElement(48.0F);
+        m_iconContainer->addChild(m_leftSpacer);
+        m_iconContainer->addChild(m_iconElement);
+        m_iconContainer->addChild(m_rightSpacer);
+    }
+    
     void updateAppearance() override {
         if (!m_background || !m_text) return;
         
@@ -548,7 +475,7 @@ class GridAppItem : public BaseAppItem {
         m_columnLayout->addChild(topSpacer);
         
         // Icon container - simpler approach
-        auto iconContainer = CRowLayoutBuilder::begin()
+        m_iconContainer = CRowLayoutBuilder::begin()
             ->gap(0)
             ->size(CDynamicSize(CDynamicSize::HT_SIZE_PERCENT,
                                 CDynamicSize::HT_SIZE_ABSOLUTE,
@@ -556,28 +483,28 @@ class GridAppItem : public BaseAppItem {
             ->commence();
         
         // Fixed-width left spacer (36px = (120-48)/2)
-        auto leftSpacer = CRectangleBuilder::begin()
+        m_leftSpacer = CRectangleBuilder::begin()
             ->color([] { return CHyprColor(0, 0, 0, 0); })
             ->size(CDynamicSize(CDynamicSize::HT_SIZE_ABSOLUTE,
                                 CDynamicSize::HT_SIZE_ABSOLUTE,
                                 {36.F, 48.F}))
             ->commence();
-        iconContainer->addChild(leftSpacer);
+        m_iconContainer->addChild(m_leftSpacer);
         
         // Icon
         m_iconElement = createIconElement(48.0F);
-        iconContainer->addChild(m_iconElement);
+        m_iconContainer->addChild(m_iconElement);
         
         // Fixed-width right spacer
-        auto rightSpacer = CRectangleBuilder::begin()
+        m_rightSpacer = CRectangleBuilder::begin()
             ->color([] { return CHyprColor(0, 0, 0, 0); })
             ->size(CDynamicSize(CDynamicSize::HT_SIZE_ABSOLUTE,
                                 CDynamicSize::HT_SIZE_ABSOLUTE,
                                 {36.F, 48.F}))
             ->commence();
-        iconContainer->addChild(rightSpacer);
+        m_iconContainer->addChild(m_rightSpacer);
         
-        m_columnLayout->addChild(iconContainer);
+        m_columnLayout->addChild(m_iconContainer);
         
         // Small gap between icon and text
         auto iconTextGap = CRectangleBuilder::begin()
@@ -590,7 +517,7 @@ class GridAppItem : public BaseAppItem {
         
         // Text with ellipsis
         m_text = CTextBuilder::begin()
-            ->text(std::string{m_app.name})
+            ->text(std::string{m_store.name(m_appId)})
             ->color([palette] { 
                 if (!palette) return CHyprColor(0.8, 0.8, 0.8, 1);
                 return palette->m_colors.text;
@@ -644,7 +571,7 @@ class GridAppItem : public BaseAppItem {
         // Hover enter
         m_background->setMouseEnter([this](const Hyprutils::Math::Vector2D&) {
             if (m_onHover) {
-                m_onHover();
+                m_onHover(m_index);
             }
         });
         
@@ -657,7 +584,7 @@ class GridAppItem : public BaseAppItem {
         m_background->setMouseButton([this](Input::eMouseButton button, bool down) {
             if (button == Input::MOUSE_BUTTON_LEFT && down) {
                 if (m_onClick) {
-                    m_onClick();
+                    m_onClick(m_index);
                 }
             }
         });
@@ -665,8 +592,114 @@ class GridAppItem : public BaseAppItem {
     
     CSharedPointer<CRectangleElement> m_background;
     CSharedPointer<CColumnLayoutElement> m_columnLayout;
+    CSharedPointer<CRowLayoutElement> m_iconContainer;
+    CSharedPointer<CRectangleElement> m_leftSpacer;
+    CSharedPointer<CRectangleElement> m_rightSpacer;
     CSharedPointer<CTextElement> m_text;
     CSharedPointer<IElement> m_iconElement;
+};
+
+// ============================================
+// CommandItem - For Run-Command Mode
+// ============================================
+
+class CommandItem {
+  public:
+    CommandItem(std::string command,
+                std::function<void()> onHover = nullptr,
+                std::function<void()> onClick = nullptr)
+        : m_command(std::move(command)), m_onHover(onHover), m_onClick(onClick) {
+        createUI();
+    }
+    
+    CSharedPointer<IElement> getElement() const { return m_background; }
+    const std::string& getCommand() const { return m_command; }
+    
+    void setActive(bool active) {
+        if (m_active == active || !m_background || !m_text) return;
+        m_active = active;
+        
+        auto palette = CPalette::palette();
+        
+        if (auto builder = m_background->rebuild()) {
+            if (palette) {
+                auto& colors = palette->m_colors;
+                builder->color([this, colors] { 
+                    return m_active ? colors.accent.mix(colors.base, 0.3) 
+                                   : CHyprColor(0, 0, 0, 0);
+                })->commence();
+            } else {
+                builder->color([this] { 
+                    return m_active ? CHyprColor(0.2, 0.4, 0.8, 0.8) 
+                                   : CHyprColor(0, 0, 0, 0);
+                })->commence();
+            }
+        }
+        if (auto builder = m_text->rebuild()) {
+            if (palette) {
+                auto& colors = palette->m_colors;
+                builder->color([this, colors] { 
+                    return m_active ? colors.brightText : colors.text;
+                })->commence();
+            } else {
+                builder->color([this] { 
+                    return m_active ? CHyprColor(1, 1, 1, 1) : CHyprColor(0.8, 0.8, 0.8, 1);
+                })->commence();
+            }
+        }
+        
+        m_background->forceReposition();
+    }
+    
+  private:
+    void createUI() {
+        auto palette = CPalette::palette();
+        
+        m_background = CRectangleBuilder::begin()
+            ->color([] { return CHyprColor(0, 0, 0, 0); })
+            ->rounding(palette ? palette->m_vars.smallRounding : 6)
+            ->size(CDynamicSize(CDynamicSize::HT_SIZE_PERCENT,
+                                CDynamicSize::HT_SIZE_ABSOLUTE,
+                                {1.0F, 36.F}))
+            ->commence();
+
+        auto rowLayout = CRowLayoutBuilder::begin()
+            ->size(CDynamicSize(CDynamicSize::HT_SIZE_PERCENT,
+                                CDynamicSize::HT_SIZE_PERCENT,
+                                {1.0F, 1.0F}))
+            ->commence();
+        rowLayout->setMargin(8);
+
+        m_text = CTextBuilder::begin()
+            ->text(std::string{m_command})
+            ->color([palette] { 
+                if (!palette) return CHyprColor(0.8, 0.8, 0.8, 1);
+                return palette->m_colors.text;
+            })
+            ->fontFamily("monospace")
+            ->commence();
+        rowLayout->addChild(m_text);
+
+        m_background->addChild(rowLayout);
+        
+        m_background->setReceivesMouse(true);
+        m_background->setMouseEnter([this](const Hyprutils::Math::Vector2D&) {
+            if (m_onHover) {
+                m_onHover();
+            }
+        });
+        m_background->setMouseButton([this](Input::eMouseButton button, bool down) {
+            if (button == Input::MOUSE_BUTTON_LEFT && down && m_onClick) {
+                m_onClick();
+            }
+        });
+    }
+    
+    std::string m_command;
+    bool m_active = false;
+    
+    CSharedPointer<CRectangleElement> m_background;
+    CSharedPointer<CTextElement> m_text;
     
     std::function<void()> m_onHover;
     std::function<void()> m_onClick;
@@ -688,7 +721,23 @@ class AppLauncher {
         }
         
         m_appDatabase = std::make_unique<AppDatabase>();
-        m_filteredApps = m_appDatabase->getAllApps();
+        m_appSearch = std::make_unique<AppSearch>(*m_appDatabase);
+        // Searched once up front so the first page already leads with the
+        // most used apps
+        const auto& initial = m_appSearch->search("");
+        m_filteredApps.assign(initial.begin(), initial.end());
+        
+        // m_appSearch belongs to the worker thread from here on
+        m_searchWorker = std::make_unique<SearchWorker<std::vector<AppStore::AppId>>>(
+            [this](const std::string& query, const CancelToken& cancel, std::vector<AppStore::AppId>& out) {
+                const auto& results = m_appSearch->search(query, cancel);
+                if (!cancel.cancelled()) {
+                    out.assign(results.begin(), results.end());
+                }
+            },
+            [this](const std::string& query, std::vector<AppStore::AppId>& results) {
+                showSearchResults(query, results);
+            });
         
         // Set initial view mode based on config
         std::string defaultView = m_config->getDefaultView();
@@ -709,13 +758,18 @@ class AppLauncher {
         
         createUI();
         setupEventHandlers();
+        setupAppWatcher();
+        m_backend->addFd(m_searchWorker->eventFd(), [this] {
+            m_searchWorker->dispatch();
+        });
+        scheduleDetailLoading();
 
         std::cout << "\n=== App Launcher Ready ===" << std::endl;
         std::cout << "Apps: " << m_filteredApps.size() << std::endl;
         std::cout << "Controls: ↑/↓/←/→ = Navigate, ↵ = Launch, ⎋ = Close" << std::endl;
         std::cout << "Ctrl+Esc: Switch between list/grid view" << std::endl;
         std::cout << "Mouse: Hover to select, Click to launch" << std::endl;
-        std::cout << "Type to search applications" << std::endl;
+        std::cout << "Type to search applications, start with > to run a command (Tab completes)" << std::endl;
         std::cout << "===========================\n" << std::endl;
 
         m_window->open();
@@ -798,7 +852,7 @@ class AppLauncher {
 
         // Create search box with custom text handling
         m_searchBox = CTextboxBuilder::begin()
-            ->placeholder("Search applications...")
+            ->placeholder("Search applications... (> runs a command)")
             ->defaultText("")
             ->multiline(false)
             ->onTextEdited([this](CSharedPointer<CTextboxElement> textbox, const std::string& text) {
@@ -813,7 +867,7 @@ class AppLauncher {
             ->scrollY(true)
             ->size(CDynamicSize(CDynamicSize::HT_SIZE_PERCENT,
                                 CDynamicSize::HT_SIZE_ABSOLUTE,
-                                {1.0F, 500.F}))
+                                {1.0F, DEFAULT_SCROLL_HEIGHT}))
             ->commence();
         m_scrollArea->setGrow(true);
 
@@ -835,10 +889,16 @@ class AppLauncher {
     void updateView() {
         if (!m_scrollArea) return;
         
-        m_scrollArea->clearChildren();
-        m_appItems.clear();
+        m_commandItems.clear();
+        
+        if (m_commandMode) {
+            clearResultView();
+            createCommandView();
+            return;
+        }
         
         if (m_filteredApps.empty()) {
+            clearResultView();
             auto message = CTextBuilder::begin()
                 ->text("No applications found" + (m_currentQuery.empty() ? "" : " matching \"" + m_currentQuery + "\""))
                 ->color([] { return CHyprColor(0.7, 0.7, 0.7, 1); })
@@ -848,149 +908,167 @@ class AppLauncher {
             return;
         }
         
-        if (m_viewMode == ViewMode::LIST) {
-            createListView();
-        } else {
-            createGridView();
+        // Laid out as a list or a grid by m_viewHost, which builds items
+        // for the visible rows only. Its container stays from one query to
+        // the next, and items of apps still in view stay in it.
+        if (!m_viewHost.container) {
+            m_scrollArea->clearChildren();
         }
+        m_scrollArea->setScroll({0.F, 0.F});
+        m_resultView.show(m_filteredApps, viewportHeight());
         
-        if (!m_appItems.empty()) {
-            m_selectedIndex = 0;
-            m_appItems[0]->setActive(true);
-            
-            if (m_viewMode == ViewMode::GRID) {
-                updateGridPosition();
-            }
+        m_selectedIndex = 0;
+        m_resultView.setActive(0);
+        if (m_viewMode == ViewMode::GRID) {
+            updateGridPosition();
         }
     }
     
-    void createListView() {
-        auto listLayout = CColumnLayoutBuilder::begin()
-            ->gap(2)
-            ->size(CDynamicSize(CDynamicSize::HT_SIZE_PERCENT,
-                                CDynamicSize::HT_SIZE_AUTO,
-                                {1.0F, 1.0F}))
-            ->commence();
+    // Empty the scroll area, dropping the result items
+    void clearResultView() {
+        if (m_scrollArea) {
+            m_scrollArea->clearChildren();
+        }
+        m_viewHost.container.reset();
+        m_resultView.clear();
+    }
+    
+    float viewportHeight() const {
+        // Zero until the window has been laid out once
+        const float height = static_cast<float>(m_scrollArea->size().y);
+        return height > 0 ? height : DEFAULT_SCROLL_HEIGHT;
+    }
+    
+    // Move m_resultView's window of items to where the scroll area is
+    void syncViewport() {
+        if (!m_scrollArea || m_resultView.empty()) return;
+        m_resultView.setViewport(static_cast<float>(m_scrollArea->getCurrentScroll().y), viewportHeight());
+    }
+    
+    // The scroll area repositions its content whenever it scrolls or
+    // resizes; the items are moved once that is over
+    void queueViewportSync() {
+        if (m_viewportSyncQueued) return;
+        m_viewportSyncQueued = true;
+        m_backend->addIdle([this] {
+            m_viewportSyncQueued = false;
+            syncViewport();
+        });
+    }
+    
+    // Builds and places m_resultView's items: ListAppItems one below the
+    // other, or GridAppItems in rows of the configured column count. Items
+    // sit at absolute positions in a container as large as all results, so
+    // the scrollbar covers the rows that have no items.
+    struct ViewHost {
+        using ItemPtr = std::shared_ptr<BaseAppItem>;
         
-        for (size_t i = 0; i < m_filteredApps.size(); ++i) {
-            const auto& app = m_filteredApps[i];
-            
-            // Create callbacks for this specific item
-            auto onHover = [this, i]() {
-                selectItem(i);
+        AppLauncher& launcher;
+        
+        CSharedPointer<CRectangleElement> container;
+        GridGeometry geometry;
+        float columnPitch = 0;
+        
+        uint32_t version(AppStore::AppId appId) const {
+            return launcher.m_appDatabase->apps().version(appId);
+        }
+        
+        ItemPtr makeItem(size_t index, AppStore::AppId appId) {
+            // The item passes the index of the result it shows at the time
+            auto onHover = [this](size_t result) {
+                launcher.selectItem(result);
             };
             
-            auto onClick = [this, i]() {
-                selectItem(i);
-                launchSelectedApp();
+            auto onClick = [this](size_t result) {
+                launcher.selectItem(result);
+                launcher.launchSelectedApp();
             };
             
-            auto appItem = std::make_shared<ListAppItem>(app, m_backend, onHover, onClick);
-            if (appItem->getElement()) {
-                listLayout->addChild(appItem->getElement());
-                m_appItems.push_back(appItem);
+            ItemPtr appItem;
+            if (launcher.m_viewMode == ViewMode::LIST) {
+                appItem = std::make_shared<ListAppItem>(launcher.m_appDatabase->apps(), index, appId,
+                                                        launcher.m_backend, onHover, onClick);
+            } else {
+                appItem = std::make_shared<GridAppItem>(launcher.m_appDatabase->apps(), index, appId,
+                                                        launcher.m_backend, onHover, onClick);
             }
+            return appItem->getElement() ? appItem : nullptr;
         }
         
-        m_scrollArea->addChild(listLayout);
-    }
-    
-    void createGridView() {
-        // Use config values
-        const int COLUMN_COUNT = m_config->getColumnCount();
-        const float ITEM_WIDTH = static_cast<float>(m_config->getGridItemWidth());
-        const float ITEM_HEIGHT = static_cast<float>(m_config->getGridItemHeight());
-        const float ROW_GAP = static_cast<float>(m_config->getGridVerticalGap());
-        const float COLUMN_GAP = static_cast<float>(m_config->getGridHorizontalGap());
-        
-        size_t numApps = m_filteredApps.size();
-        size_t numRows = (numApps + COLUMN_COUNT - 1) / COLUMN_COUNT;
-        
-        // Calculate total grid dimensions
-        float totalGridWidth = (ITEM_WIDTH * COLUMN_COUNT) + 
-                              (COLUMN_GAP * (COLUMN_COUNT - 1));
-        float totalGridHeight = (ITEM_HEIGHT * numRows) + 
-                               (ROW_GAP * (numRows - 1));
-        
-        // Create a container for the grid
-        auto gridContainer = CRectangleBuilder::begin()
-            ->color([] { return CHyprColor(0, 0, 0, 0); })
-            ->size(CDynamicSize(CDynamicSize::HT_SIZE_ABSOLUTE,
-                                CDynamicSize::HT_SIZE_ABSOLUTE,
-                                {totalGridWidth, totalGridHeight}))
-            ->commence();
-        
-        // Create the main grid layout
-        auto gridLayout = CColumnLayoutBuilder::begin()
-            ->gap(static_cast<size_t>(ROW_GAP))
-            ->size(CDynamicSize(CDynamicSize::HT_SIZE_PERCENT,
-                                CDynamicSize::HT_SIZE_PERCENT,
-                                {1.0F, 1.0F}))
-            ->commence();
+        void bindItem(const ItemPtr& item, size_t index, AppStore::AppId appId) {
+            item->bind(index, appId);
+        }
         
-        // Create rows
-        for (size_t row = 0; row < numRows; row++) {
-            auto rowLayout = CRowLayoutBuilder::begin()
-                ->gap(static_cast<size_t>(COLUMN_GAP))
-                ->size(CDynamicSize(CDynamicSize::HT_SIZE_PERCENT,
-                                    CDynamicSize::HT_SIZE_ABSOLUTE,
-                                    {1.0F, ITEM_HEIGHT}))
-                ->commence();
+        GridGeometry beginLayout(size_t count) {
+            CDynamicSize::eSizingType widthType = CDynamicSize::HT_SIZE_PERCENT;
+            float width = 1.0F;
+            float gap = LIST_ROW_GAP;
             
-            // Add items to this row
-            for (int col = 0; col < COLUMN_COUNT; col++) {
-                size_t index = row * COLUMN_COUNT + col;
-                
-                if (index >= numApps) {
-                    // Add empty placeholder to maintain grid alignment
-                    auto empty = CRectangleBuilder::begin()
-                        ->color([] { return CHyprColor(0, 0, 0, 0); })
-                        ->size(CDynamicSize(CDynamicSize::HT_SIZE_ABSOLUTE,
-                                            CDynamicSize::HT_SIZE_ABSOLUTE,
-                                            {ITEM_WIDTH, ITEM_HEIGHT}))
-                        ->commence();
-                    rowLayout->addChild(empty);
-                    continue;
-                }
-                
-                const auto& app = m_filteredApps[index];
-                size_t itemIndex = m_appItems.size(); // Current size before adding
-                
-                // Create callbacks for this specific item
-                auto onHover = [this, itemIndex]() {
-                    selectItem(itemIndex);
-                };
-                
-                auto onClick = [this, itemIndex]() {
-                    selectItem(itemIndex);
-                    launchSelectedApp();
-                };
+            if (launcher.m_viewMode == ViewMode::LIST) {
+                geometry = {1, LIST_ITEM_HEIGHT + LIST_ROW_GAP};
+                columnPitch = 0;
+            } else {
+                const auto& config = *launcher.m_config;
+                const size_t columns = static_cast<size_t>(std::max(config.getColumnCount(), 1));
+                const float itemWidth = static_cast<float>(config.getGridItemWidth());
+                const float columnGap = static_cast<float>(config.getGridHorizontalGap());
+                gap = static_cast<float>(config.getGridVerticalGap());
                 
-                auto appItem = std::make_shared<GridAppItem>(app, m_backend, onHover, onClick);
-                if (appItem->getElement()) {
-                    rowLayout->addChild(appItem->getElement());
-                    m_appItems.push_back(appItem);
-                }
+                geometry = {columns, static_cast<float>(config.getGridItemHeight()) + gap};
+                columnPitch = itemWidth + columnGap;
+                widthType = CDynamicSize::HT_SIZE_ABSOLUTE;
+                width = columnPitch * columns - columnGap;
             }
             
-            gridLayout->addChild(rowLayout);
+            const size_t rows = (count + geometry.columns - 1) / geometry.columns;
+            const float height = std::max(geometry.rowPitch * rows - gap, 0.F);
+            
+            CDynamicSize size(widthType, CDynamicSize::HT_SIZE_ABSOLUTE, {width, height});
+            
+            // Resized in place, so the items already in it can stay
+            if (container) {
+                container->rebuild()->size(std::move(size))->commence();
+                return geometry;
+            }
+            container = CRectangleBuilder::begin()
+                ->color([] { return CHyprColor(0, 0, 0, 0); })
+                ->size(std::move(size))
+                ->commence();
+            container->setRepositioned([this] {
+                launcher.queueViewportSync();
+            });
+            launcher.m_scrollArea->addChild(container);
+            return geometry;
         }
         
-        gridContainer->addChild(gridLayout);
-        m_scrollArea->addChild(gridContainer);
-    }
-    
-    void selectItem(size_t index) {
-        if (index >= m_appItems.size()) return;
+        void placeItem(const ItemPtr& item, size_t index) {
+            auto element = item->getElement();
+            element->setPositionMode(IElement::HT_POSITION_ABSOLUTE);
+            position(element, index);
+            container->addChild(element);
+        }
+        
+        void moveItem(const ItemPtr& item, size_t index) {
+            // Same app, so only the index its callbacks report changes
+            item->bind(index, item->getAppId());
+            position(item->getElement(), index);
+        }
+        
+        void removeItem(const ItemPtr& item) {
+            container->removeChild(item->getElement());
+        }
         
-        // Deselect current item
-        if (m_selectedIndex < m_appItems.size()) {
-            m_appItems[m_selectedIndex]->setActive(false);
+        void position(const CSharedPointer<IElement>& element, size_t index) const {
+            element->setAbsolutePosition({columnPitch * static_cast<float>(index % geometry.columns),
+                                          geometry.rowPitch * static_cast<float>(index / geometry.columns)});
         }
+    };
+    
+    void selectItem(size_t index) {
+        if (index >= m_resultView.size()) return;
         
-        // Select new item
         m_selectedIndex = index;
-        m_appItems[m_selectedIndex]->setActive(true);
+        m_resultView.setActive(m_selectedIndex);
         
         // Update grid position if in grid view
         if (m_viewMode == ViewMode::GRID) {
@@ -1002,12 +1080,214 @@ class AppLauncher {
     
     void filterApps(const std::string& query) {
         m_currentQuery = query;
-        m_filteredApps = m_appDatabase->filterApps(query);
+        m_commandMode = !query.empty() && query.front() == COMMAND_PREFIX;
+        
+        if (m_commandMode) {
+            m_searchWorker->cancel();
+            updateCompletions();
+            updateView();
+        } else {
+            // Answered through showSearchResults() once the worker is done
+            m_searchWorker->submit(m_currentQuery);
+        }
+    }
+    
+    void showSearchResults(const std::string& query, std::vector<AppStore::AppId>& results) {
+        // A refresh that changed nothing keeps the current items and selection
+        if (!m_resultsStale && query == m_shownQuery && results == m_filteredApps) return;
+        
+        m_resultsStale = false;
+        m_shownQuery = query;
+        m_filteredApps.swap(results);
         updateView();
     }
     
+    // ============================================
+    // Run-Command Mode
+    // ============================================
+    
+    // Text after the '>' prefix, without leading blanks
+    std::string_view commandText() const {
+        std::string_view text = m_currentQuery;
+        text.remove_prefix(1);
+        size_t start = text.find_first_not_of(" \t");
+        return start == std::string_view::npos ? std::string_view{} : text.substr(start);
+    }
+    
+    void updateCompletions() {
+        const size_t MAX_COMPLETIONS = 50;
+        
+        // Complete the program name only; once arguments follow it the
+        // typed line is run as-is
+        std::string_view command = commandText();
+        if (command.empty() || command.find_first_of(" \t") != std::string_view::npos) {
+            m_completions.clear();
+        } else {
+            m_appDatabase->pathIndex().complete(command, MAX_COMPLETIONS, m_completions);
+        }
+        m_commandSelection = 0;
+    }
+    
+    void createCommandView() {
+        if (m_completions.empty()) {
+            std::string_view command = commandText();
+            auto message = CTextBuilder::begin()
+                ->text(command.empty() ? std::string("Type a command to run")
+                                       : "Press Enter to run \"" + std::string(command) + "\"")
+                ->color([] { return CHyprColor(0.7, 0.7, 0.7, 1); })
+                ->align(eFontAlignment::HT_FONT_ALIGN_CENTER)
+                ->commence();
+            m_scrollArea->addChild(message);
+            return;
+        }
+        
+        auto listLayout = CColumnLayoutBuilder::begin()
+            ->gap(2)
+            ->size(CDynamicSize(CDynamicSize::HT_SIZE_PERCENT,
+                                CDynamicSize::HT_SIZE_AUTO,
+                                {1.0F, 1.0F}))
+            ->commence();
+        
+        for (size_t i = 0; i < m_completions.size(); ++i) {
+            auto onHover = [this, i]() {
+                selectCommand(i);
+            };
+            auto onClick = [this, i]() {
+                selectCommand(i);
+                runCommand();
+            };
+            
+            auto item = std::make_shared<CommandItem>(std::string(m_completions[i]), onHover, onClick);
+            listLayout->addChild(item->getElement());
+            m_commandItems.push_back(item);
+        }
+        
+        m_scrollArea->addChild(listLayout);
+        m_commandItems[0]->setActive(true);
+    }
+    
+    void selectCommand(size_t index) {
+        if (index >= m_commandItems.size()) return;
+        
+        m_commandItems[m_commandSelection]->setActive(false);
+        m_commandSelection = index;
+        m_commandItems[m_commandSelection]->setActive(true);
+    }
+    
+    void moveCommandSelection(int delta) {
+        if (m_commandItems.empty()) return;
+        
+        const int count = static_cast<int>(m_commandItems.size());
+        selectCommand(static_cast<size_t>((static_cast<int>(m_commandSelection) + delta + count) % count));
+    }
+    
+    // Tab: replace the typed prefix with the selected completion
+    void completeCommand() {
+        if (m_commandItems.empty() || !m_searchBox) return;
+        
+        std::string text = std::string(1, COMMAND_PREFIX) +
+                           m_commandItems[m_commandSelection]->getCommand() + " ";
+        m_searchBox->rebuild()->defaultText(std::string(text))->commence();
+        filterApps(text);
+    }
+    
+    void runCommand() {
+        // While completions are shown the selected program is run; after
+        // arguments have been typed the line is run as written
+        std::string command = m_commandItems.empty()
+            ? std::string(commandText())
+            : m_commandItems[m_commandSelection]->getCommand();
+        if (command.empty()) return;
+        
+        std::cout << "Running: " << command << std::endl;
+        std::system((command + " &").c_str());
+        closeLauncher();
+    }
+    
+    void setupAppWatcher() {
+        auto onEvents = [this] {
+            if (!m_appDatabase->readWatchEvents()) return;
+            
+            m_lastAppEvent = std::chrono::steady_clock::now();
+            if (!m_appUpdateScheduled) {
+                m_appUpdateScheduled = true;
+                scheduleAppUpdate();
+            }
+        };
+        
+        // Application directories, and $PATH for TryExec and command mode
+        for (const int fd : {m_appDatabase->watchFd(), m_appDatabase->pathWatchFd()}) {
+            if (fd >= 0) {
+                m_backend->addFd(fd, onEvents);
+            }
+        }
+    }
+    
+    void scheduleAppUpdate() {
+        // Package upgrades touch hundreds of files in a burst; wait until
+        // the directory has been quiet for a moment and apply them all at once
+        const auto QUIET_PERIOD = std::chrono::milliseconds(250);
+        
+        m_backend->addTimer(QUIET_PERIOD, [this, QUIET_PERIOD](auto, void*) {
+            if (std::chrono::steady_clock::now() - m_lastAppEvent < QUIET_PERIOD) {
+                scheduleAppUpdate();
+                return;
+            }
+            
+            m_appUpdateScheduled = false;
+            size_t changed;
+            {
+                // The search worker reads the store being updated
+                auto paused = m_searchWorker->pause();
+                changed = m_appDatabase->applyPendingChanges();
+            }
+            // A rescan leaves the details of the entries it parsed to fill in
+            scheduleDetailLoading();
+            
+            // Command mode holds views into the PATH index, which may have
+            // been rebuilt even when no application changed
+            if (changed > 0 || m_commandMode) {
+                refreshApps();
+            }
+        }, nullptr);
+    }
+    
+    void refreshApps() {
+        // Retired IDs may have been reused for other apps, so the results
+        // shown are redrawn even if the new ones have the same IDs. The
+        // items stay until then, and keep theirs by version.
+        m_resultsStale = true;
+        
+        // Completions point into the PATH index, which may have been rebuilt
+        if (m_commandMode) {
+            updateCompletions();
+            updateView();
+            return;
+        }
+        
+        // The database generation moved, so this searches from scratch
+        m_searchWorker->submit(m_currentQuery);
+    }
+    
+    void scheduleDetailLoading() {
+        if (m_detailLoadingScheduled || m_appDatabase->pendingDetails() == 0) return;
+        
+        // Exec and categories of freshly parsed entries are filled in a small
+        // batch per idle slot so typing is never held up by it
+        m_detailLoadingScheduled = true;
+        m_backend->addIdle([this] {
+            const size_t DETAIL_BATCH = 32;
+            {
+                auto paused = m_searchWorker->pause();
+                m_appDatabase->loadDetails(DETAIL_BATCH);
+            }
+            m_detailLoadingScheduled = false;
+            scheduleDetailLoading();
+        });
+    }
+    
     void updateGridPosition() {
-        if (m_viewMode != ViewMode::GRID || m_appItems.empty()) return;
+        if (m_viewMode != ViewMode::GRID || m_resultView.empty()) return;
         
         const int COLUMN_COUNT = m_config->getColumnCount();
         m_gridRow = m_selectedIndex / COLUMN_COUNT;
@@ -1015,9 +1295,7 @@ class AppLauncher {
     }
     
     void moveGridSelection(int deltaRow, int deltaCol) {
-        if (m_viewMode != ViewMode::GRID || m_appItems.empty()) return;
-        
-        m_appItems[m_selectedIndex]->setActive(false);
+        if (m_viewMode != ViewMode::GRID || m_resultView.empty()) return;
         
         const int COLUMN_COUNT = m_config->getColumnCount();
         
@@ -1025,13 +1303,13 @@ class AppLauncher {
         int newCol = static_cast<int>(m_gridCol) + deltaCol;
         
         // Wrap around rows
-        int totalRows = (m_appItems.size() + COLUMN_COUNT - 1) / COLUMN_COUNT;
+        int totalRows = (m_resultView.size() + COLUMN_COUNT - 1) / COLUMN_COUNT;
         if (newRow < 0) newRow = totalRows - 1;
         else if (newRow >= totalRows) newRow = 0;
         
         // Wrap columns within row
         size_t itemsInRow = std::min(static_cast<size_t>(COLUMN_COUNT), 
-                                   m_appItems.size() - newRow * COLUMN_COUNT);
+                                   m_resultView.size() - newRow * COLUMN_COUNT);
         if (newCol < 0) {
             newCol = itemsInRow - 1;
             newRow--;
@@ -1043,28 +1321,26 @@ class AppLauncher {
         }
         
         size_t newIndex = newRow * COLUMN_COUNT + newCol;
-        if (newIndex >= m_appItems.size()) {
-            newIndex = m_appItems.size() - 1;
+        if (newIndex >= m_resultView.size()) {
+            newIndex = m_resultView.size() - 1;
         }
         
         m_selectedIndex = newIndex;
         m_gridRow = newRow;
         m_gridCol = newCol;
         
-        m_appItems[m_selectedIndex]->setActive(true);
+        m_resultView.setActive(m_selectedIndex);
         ensureSelectionVisible();
     }
     
     void moveSelection(int delta) {
-        if (m_appItems.empty()) return;
-        
-        m_appItems[m_selectedIndex]->setActive(false);
+        if (m_resultView.empty()) return;
         
         if (m_viewMode == ViewMode::LIST) {
             // List navigation: simple up/down
             int newIndex = static_cast<int>(m_selectedIndex) + delta;
-            if (newIndex < 0) newIndex = m_appItems.size() - 1;
-            else if (newIndex >= static_cast<int>(m_appItems.size())) newIndex = 0;
+            if (newIndex < 0) newIndex = m_resultView.size() - 1;
+            else if (newIndex >= static_cast<int>(m_resultView.size())) newIndex = 0;
             
             m_selectedIndex = newIndex;
         } else {
@@ -1075,7 +1351,7 @@ class AppLauncher {
             int currentCol = static_cast<int>(m_gridCol);
             
             int newRow = currentRow + delta;
-            int totalRows = (m_appItems.size() + COLUMN_COUNT - 1) / COLUMN_COUNT;
+            int totalRows = (m_resultView.size() + COLUMN_COUNT - 1) / COLUMN_COUNT;
             
             // Wrap rows
             if (newRow < 0) newRow = totalRows - 1;
@@ -1086,7 +1362,7 @@ class AppLauncher {
             
             // Check if this position exists in the new row
             size_t itemsInNewRow = std::min(static_cast<size_t>(COLUMN_COUNT), 
-                                          m_appItems.size() - newRow * COLUMN_COUNT);
+                                          m_resultView.size() - newRow * COLUMN_COUNT);
             
             // If column position doesn't exist in new row, adjust to last column in that row
             if (currentCol >= static_cast<int>(itemsInNewRow)) {
@@ -1095,8 +1371,8 @@ class AppLauncher {
             }
             
             // Ensure index is valid
-            if (newIndex >= m_appItems.size()) {
-                newIndex = m_appItems.size() - 1;
+            if (newIndex >= m_resultView.size()) {
+                newIndex = m_resultView.size() - 1;
             }
             
             m_selectedIndex = newIndex;
@@ -1104,15 +1380,15 @@ class AppLauncher {
             m_gridCol = currentCol;
         }
         
-        m_appItems[m_selectedIndex]->setActive(true);
+        m_resultView.setActive(m_selectedIndex);
         ensureSelectionVisible();
     }
     
     void ensureSelectionVisible() {
-        if (m_appItems.empty() || !m_scrollArea) return;
+        if (m_resultView.empty() || !m_scrollArea) return;
         
         if (m_viewMode == ViewMode::LIST) {
-            const float ITEM_HEIGHT = 52.F;
+            const float ITEM_HEIGHT = LIST_ITEM_HEIGHT + LIST_ROW_GAP;
             const float SCROLL_AREA_HEIGHT = m_scrollArea->size().y;
             const float CURRENT_SCROLL = m_scrollArea->getCurrentScroll().y;
             
@@ -1141,17 +1417,42 @@ class AppLauncher {
                 m_scrollArea->setScroll({0.F, SELECTION_BOTTOM - SCROLL_AREA_HEIGHT});
             }
         }
+        
+        // Place the items of the rows scrolled to before the next frame
+        syncViewport();
     }
     
     void launchSelectedApp() {
-        if (m_selectedIndex >= m_appItems.size()) return;
-        
-        std::cout << "Launching: " << m_appItems[m_selectedIndex]->getApp().name << std::endl;
-        m_appItems[m_selectedIndex]->launch();
+        if (m_selectedIndex >= m_resultView.size()) return;
+        
+        const AppStore::AppId appId = m_resultView.appId(m_selectedIndex);
+        // Reused for another app by an update whose results are not shown yet
+        if (m_appDatabase->apps().version(appId) != m_resultView.version(m_selectedIndex)) return;
+        {
+            auto paused = m_searchWorker->pause();
+            m_appDatabase->ensureDetails(appId);
+            m_appDatabase->recordLaunch(appId);
+        }
+        std::cout << "Launching: " << m_appDatabase->apps().name(appId) << std::endl;
+        BaseAppItem::launch(m_appDatabase->apps(), appId);
         closeLauncher();
     }
     
     void closeLauncher() {
+        {
+            auto paused = m_searchWorker->pause();
+            // The launcher rarely stays open long enough for the idle batches
+            // to finish, and the index is only written once they have
+            m_appDatabase->finishDetails();
+            const auto& cache = m_appSearch->cache();
+            std::cout << "Search cache: " << cache.hits() << "/" << cache.lookups() << " hits ("
+                      << static_cast<int>(cache.hitRate() * 100 + 0.5) << "%)" << std::endl;
+        }
+        const auto view = m_resultView.stats();
+        if (view.updates > 0) {
+            std::cout << "View churn: " << view.churn() << " items built, rebound or removed over "
+                      << view.updates << " updates, " << view.kept + view.moved << " kept" << std::endl;
+        }
         std::cout << "Closing launcher" << std::endl;
         if (m_window) {
             m_window->close();
@@ -1190,11 +1491,25 @@ class AppLauncher {
                     break;
                     
                 case XKB_KEY_Down:
-                    moveSelection(+1);
+                    if (m_commandMode) {
+                        moveCommandSelection(+1);
+                    } else {
+                        moveSelection(+1);
+                    }
                     break;
                     
                 case XKB_KEY_Up:
-                    moveSelection(-1);
+                    if (m_commandMode) {
+                        moveCommandSelection(-1);
+                    } else {
+                        moveSelection(-1);
+                    }
+                    break;
+                    
+                case XKB_KEY_Tab:
+                    if (m_commandMode) {
+                        completeCommand();
+                    }
                     break;
                     
                 case XKB_KEY_Right:
@@ -1211,7 +1526,11 @@ class AppLauncher {
                     
                 case XKB_KEY_Return:
                 case XKB_KEY_KP_Enter:
-                    launchSelectedApp();
+                    if (m_commandMode) {
+                        runCommand();
+                    } else {
+                        launchSelectedApp();
+                    }
                     break;
                     
                 default:
@@ -1223,6 +1542,8 @@ class AppLauncher {
     
     void toggleViewMode() {
         m_viewMode = (m_viewMode == ViewMode::LIST) ? ViewMode::GRID : ViewMode::LIST;
+        // Pooled items are of the other kind
+        clearResultView();
         updateView();
         std::cout << "Switched to " << (m_viewMode == ViewMode::LIST ? "list" : "grid") << " view" << std::endl;
         
@@ -1245,8 +1566,30 @@ class AppLauncher {
     CSharedPointer<CScrollAreaElement> m_scrollArea;
     
     std::unique_ptr<AppDatabase> m_appDatabase;
-    std::vector<DesktopApp> m_filteredApps;
-    std::vector<std::shared_ptr<BaseAppItem>> m_appItems;
+    std::unique_ptr<AppSearch> m_appSearch;
+    // Declared after what it searches, so it stops before they are destroyed
+    std::unique_ptr<SearchWorker<std::vector<AppStore::AppId>>> m_searchWorker;
+    // Results shown, and the query they answer
+    std::vector<AppStore::AppId> m_filteredApps;
+    std::string m_shownQuery;
+    // Set when the app list changed under them, until new results are shown
+    bool m_resultsStale = false;
+    ViewHost m_viewHost{*this};
+    ResultView<ViewHost> m_resultView{m_viewHost};
+    bool m_viewportSyncQueued = false;
+    
+    // Run-command mode, entered by starting the query with '>'
+    static constexpr char COMMAND_PREFIX = '>';
+    bool m_commandMode = false;
+    std::vector<std::string_view> m_completions;
+    std::vector<std::shared_ptr<CommandItem>> m_commandItems;
+    size_t m_commandSelection = 0;
+    
+    // Height of a ListAppItem and the gap below it
+    static constexpr float LIST_ITEM_HEIGHT = 50.F;
+    static constexpr float LIST_ROW_GAP = 2.F;
+    // Until the scroll area has been laid out and knows its own
+    static constexpr float DEFAULT_SCROLL_HEIGHT = 500.F;
     
     ViewMode m_viewMode = ViewMode::LIST;
     size_t m_selectedIndex = 0;
@@ -1254,6 +1597,10 @@ class AppLauncher {
     size_t m_gridCol = 0;
     std::string m_currentQuery;
     
+    bool m_appUpdateScheduled = false;
+    bool m_detailLoadingScheduled = false;
+    std::chrono::steady_clock::time_point m_lastAppEvent;
+    
     Hyprutils::Signal::CHyprSignalListener m_keyboardListener;
 };
 
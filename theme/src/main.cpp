@@ -9,6 +9,11 @@
 #include <hyprtoolkit/element/Image.hpp>
 #include <hyprtoolkit/system/Icons.hpp>
 #include <hyprutils/memory/SharedPtr.hpp>
+#include "IndexedKeys.hpp"
+#include "RefinementStack.hpp"
+#include "SearchKey.hpp"
+#include "SearchWorker.hpp"
+#include "VirtualGrid.hpp"
 #include <functional>
 #include <iostream>
 #include <vector>
@@ -32,7 +37,7 @@ struct WallpaperItem {
     std::string filename;
     std::string path;
     fs::path filepath;
-    std::string lowercaseFilename; // For case-insensitive search
+    std::string searchKey; // SearchKey of the filename, built once at load
     
     bool operator<(const WallpaperItem& other) const {
         return filename < other.filename;
@@ -97,9 +102,7 @@ class WallpaperDatabase {
                     item.filename = entry.path().filename().string();
                     item.path = entry.path().string();
                     item.filepath = entry.path();
-                    item.lowercaseFilename = item.filename;
-                    std::transform(item.lowercaseFilename.begin(), item.lowercaseFilename.end(), 
-                                  item.lowercaseFilename.begin(), ::tolower);
+                    item.searchKey = SearchKey::make(item.filename);
                     
                     m_allWallpapers.push_back(item);
                 }
@@ -119,10 +122,10 @@ class WallpaperDatabase {
 
 class GridWallpaperItem {
   public:
-    GridWallpaperItem(const WallpaperItem& wallpaper, CSharedPointer<IBackend> backend,
-                     std::function<void()> onHover = nullptr,
-                     std::function<void()> onClick = nullptr)
-        : m_wallpaper(wallpaper), m_backend(backend), m_onHover(onHover), m_onClick(onClick) {
+    GridWallpaperItem(const WallpaperItem& wallpaper, size_t index, CSharedPointer<IBackend> backend,
+                     std::function<void(size_t)> onHover = nullptr,
+                     std::function<void(size_t)> onClick = nullptr)
+        : m_wallpaper(&wallpaper), m_index(index), m_backend(backend), m_onHover(onHover), m_onClick(onClick) {
         createUI();
     }
     
@@ -170,6 +173,20 @@ class GridWallpaperItem {
     
     bool isVisible() const { return m_visible; }
     
+    // Show wallpaper `index`, reusing the elements
+    void bind(size_t index, const WallpaperItem& wallpaper) {
+        m_index = index;
+        if (&wallpaper == m_wallpaper || !m_image || !m_text) return;
+        m_wallpaper = &wallpaper;
+        
+        if (auto builder = m_image->rebuild()) {
+            builder->path(std::string{m_wallpaper->path})->commence();
+        }
+        if (auto builder = m_text->rebuild()) {
+            builder->text(std::string{m_wallpaper->filename})->commence();
+        }
+    }
+    
     void updateAppearance() {
         if (!m_background || !m_text) return;
         
@@ -206,20 +223,13 @@ class GridWallpaperItem {
         m_background->forceReposition();
     }
     
-    const WallpaperItem& getWallpaper() const { return m_wallpaper; }
+    const WallpaperItem& getWallpaper() const { return *m_wallpaper; }
     
-    bool matchesFilter(const std::string& filter) const {
-        if (filter.empty()) return true;
-        
-        // Case-insensitive search
-        return m_wallpaper.lowercaseFilename.find(filter) != std::string::npos;
-    }
-    
-    void select() {
+    static void select(const WallpaperItem& wallpaper) {
         // Send notification
-        std::string command = "notify-send \"Theme App\" \"Selected: " + m_wallpaper.filename + "\"";
+        std::string command = "notify-send \"Theme App\" \"Selected: " + wallpaper.filename + "\"";
         std::system(command.c_str());
-        std::cout << "Selected wallpaper: " << m_wallpaper.filename << std::endl;
+        std::cout << "Selected wallpaper: " << wallpaper.filename << std::endl;
     }
     
   private:
@@ -259,8 +269,8 @@ class GridWallpaperItem {
             ->commence();
         
         // Load and display the image
-        auto imageElement = CImageBuilder::begin()
-            ->path(std::string{m_wallpaper.path})
+        m_image = CImageBuilder::begin()
+            ->path(std::string{m_wallpaper->path})
             ->size(CDynamicSize(CDynamicSize::HT_SIZE_PERCENT,
                                 CDynamicSize::HT_SIZE_PERCENT,
                                 {1.0F, 1.0F}))
@@ -268,7 +278,7 @@ class GridWallpaperItem {
             ->rounding(palette ? palette->m_vars.smallRounding : 8)
             ->sync(false)
             ->commence();
-        imageContainer->addChild(imageElement);
+        imageContainer->addChild(m_image);
         
         m_columnLayout->addChild(imageContainer);
         
@@ -283,7 +293,7 @@ class GridWallpaperItem {
         
         // Text label (filename) with ellipsis
         m_text = CTextBuilder::begin()
-            ->text(std::string{m_wallpaper.filename})
+            ->text(std::string{m_wallpaper->filename})
             ->color([palette] { 
                 if (!palette) return CHyprColor(0.8, 0.8, 0.8, 1);
                 return palette->m_colors.text;
@@ -318,7 +328,7 @@ class GridWallpaperItem {
         // Hover enter
         m_background->setMouseEnter([this](const Hyprutils::Math::Vector2D&) {
             if (m_onHover) {
-                m_onHover();
+                m_onHover(m_index);
             }
         });
         
@@ -331,23 +341,27 @@ class GridWallpaperItem {
         m_background->setMouseButton([this](Input::eMouseButton button, bool down) {
             if (button == Input::MOUSE_BUTTON_LEFT && down) {
                 if (m_onClick) {
-                    m_onClick();
+                    m_onClick(m_index);
                 }
             }
         });
     }
     
-    WallpaperItem m_wallpaper;
+    // Owned by the WallpaperDatabase
+    const WallpaperItem* m_wallpaper;
+    size_t m_index;
     CSharedPointer<IBackend> m_backend;
     bool m_active = false;
     bool m_visible = true;
     
     CSharedPointer<CRectangleElement> m_background;
     CSharedPointer<CColumnLayoutElement> m_columnLayout;
+    CSharedPointer<CImageElement> m_image;
     CSharedPointer<CTextElement> m_text;
     
-    std::function<void()> m_onHover;
-    std::function<void()> m_onClick;
+    // Called with the index of the wallpaper the item shows at the time
+    std::function<void(size_t)> m_onHover;
+    std::function<void(size_t)> m_onClick;
 };
 
 // ============================================
@@ -364,6 +378,14 @@ class ThemeApp {
         
         m_wallpaperDatabase = std::make_unique<WallpaperDatabase>();
         
+        m_filterWorker = std::make_unique<SearchWorker<std::vector<size_t>>>(
+            [this](const std::string& filter, const CancelToken& cancel, std::vector<size_t>& out) {
+                searchItems(filter, cancel, out);
+            },
+            [this](const std::string&, std::vector<size_t>& matches) {
+                showFilterResults(matches);
+            });
+        
         std::cout << "Theme App: Found " << m_wallpaperDatabase->getAllWallpapers().size() 
                   << " wallpaper images in Downloads" << std::endl;
     }
@@ -376,6 +398,9 @@ class ThemeApp {
         
         createUI();
         setupEventHandlers();
+        m_backend->addFd(m_filterWorker->eventFd(), [this] {
+            m_filterWorker->dispatch();
+        });
 
         std::cout << "\n=== Theme App Ready ===" << std::endl;
         std::cout << "Wallpapers: " << m_wallpaperDatabase->getAllWallpapers().size() << std::endl;
@@ -484,7 +509,7 @@ class ThemeApp {
             ->scrollY(true)
             ->size(CDynamicSize(CDynamicSize::HT_SIZE_PERCENT,
                                 CDynamicSize::HT_SIZE_ABSOLUTE,
-                                {1.0F, 500.F}))
+                                {1.0F, DEFAULT_SCROLL_HEIGHT}))
             ->commence();
         m_scrollArea->setGrow(true);
         m_mainLayout->addChild(m_scrollArea);
@@ -498,9 +523,18 @@ class ThemeApp {
     }
     
     void createGridContainer() {
+        // The filter worker reads the keys and matches rebuilt here
+        auto paused = m_filterWorker->pause();
+        
         // Clear previous state
-        m_gridItems.clear();
+        if (m_gridContainer) {
+            m_gridContainer->clearChildren();
+        }
+        m_cells.clear();
         m_visibleItems.clear();
+        m_shown.clear();
+        m_filterStack.clear();
+        m_searchKeys.clear();
         m_selectedIndex = 0;
         
         auto& wallpapers = m_wallpaperDatabase->getAllWallpapers();
@@ -524,13 +558,6 @@ class ThemeApp {
             return;
         }
         
-        // Hardcoded grid configuration
-        const int COLUMN_COUNT = 4;
-        const float ITEM_WIDTH = 180.0F;
-        const float ITEM_HEIGHT = 180.0F;
-        const float ROW_GAP = 10.0F;
-        const float COLUMN_GAP = 10.0F;
-        
         size_t numWallpapers = wallpapers.size();
         size_t numRows = (numWallpapers + COLUMN_COUNT - 1) / COLUMN_COUNT;
         
@@ -540,106 +567,152 @@ class ThemeApp {
         float totalGridHeight = (ITEM_HEIGHT * numRows) + 
                                (ROW_GAP * (numRows - 1));
         
-        // Create a container for the grid
+        // The container is as large as the whole grid, so the scrollbar
+        // covers it, but holds items only for the rows in view
         m_gridContainer = CRectangleBuilder::begin()
             ->color([] { return CHyprColor(0, 0, 0, 0); })
             ->size(CDynamicSize(CDynamicSize::HT_SIZE_ABSOLUTE,
                                 CDynamicSize::HT_SIZE_ABSOLUTE,
                                 {totalGridWidth, totalGridHeight}))
             ->commence();
+        m_gridContainer->setRepositioned([this] {
+            queueViewportSync();
+        });
         
-        // Create the main grid layout (rows)
-        m_gridLayout = CColumnLayoutBuilder::begin()
-            ->gap(static_cast<size_t>(ROW_GAP))
-            ->size(CDynamicSize(CDynamicSize::HT_SIZE_PERCENT,
-                                CDynamicSize::HT_SIZE_PERCENT,
-                                {1.0F, 1.0F}))
-            ->commence();
+        // Initially all items are visible
+        for (size_t index = 0; index < numWallpapers; ++index) {
+            m_searchKeys.append(wallpapers[index].searchKey);
+            m_visibleItems.push_back(index);
+        }
+        m_shown.assign(numWallpapers, 1);
         
-        // Create rows
-        for (size_t row = 0; row < numRows; row++) {
-            auto rowLayout = CRowLayoutBuilder::begin()
-                ->gap(static_cast<size_t>(COLUMN_GAP))
-                ->size(CDynamicSize(CDynamicSize::HT_SIZE_PERCENT,
-                                    CDynamicSize::HT_SIZE_ABSOLUTE,
-                                    {1.0F, ITEM_HEIGHT}))
-                ->commence();
+        m_scrollArea->addChild(m_gridContainer);
+        m_cells.reset(numWallpapers, {static_cast<size_t>(COLUMN_COUNT), ITEM_HEIGHT + ROW_GAP},
+                      static_cast<float>(m_scrollArea->getCurrentScroll().y), viewportHeight());
+        
+        if (m_searchKeys.indexed()) {
+            std::cout << "Indexed " << m_searchKeys.size() << " filenames ("
+                      << m_searchKeys.trigrams().trigramCount() << " trigrams, "
+                      << m_searchKeys.trigrams().postingBytes() / 1024 << " KiB of postings)" << std::endl;
+        }
+        
+        // Select first item
+        selectFirstVisibleItem();
+    }
+    
+    float viewportHeight() const {
+        // Zero until the window has been laid out once
+        const float height = static_cast<float>(m_scrollArea->size().y);
+        return height > 0 ? height : DEFAULT_SCROLL_HEIGHT;
+    }
+    
+    // Move the items to the rows scrolled to
+    void syncViewport() {
+        if (!m_scrollArea || m_cells.count() == 0) return;
+        m_cells.setViewport(static_cast<float>(m_scrollArea->getCurrentScroll().y), viewportHeight());
+    }
+    
+    // The scroll area repositions the grid whenever it scrolls or resizes;
+    // the items are moved once that is over
+    void queueViewportSync() {
+        if (m_viewportSyncQueued) return;
+        m_viewportSyncQueued = true;
+        m_backend->addIdle([this] {
+            m_viewportSyncQueued = false;
+            syncViewport();
+        });
+    }
+    
+    // Builds, rebinds and places the items of m_cells
+    struct CellHost {
+        using CellPtr = std::shared_ptr<GridWallpaperItem>;
+        
+        ThemeApp& app;
+        
+        CellPtr makeCell(size_t index) {
+            // The item passes the index of the wallpaper it shows at the time
+            auto onHover = [this](size_t wallpaper) {
+                app.selectItem(wallpaper);
+            };
             
-            // Add items to this row
-            for (int col = 0; col < COLUMN_COUNT; col++) {
-                size_t index = row * COLUMN_COUNT + col;
-                
-                if (index >= numWallpapers) {
-                    // Add empty placeholder to maintain grid alignment
-                    auto empty = CRectangleBuilder::begin()
-                        ->color([] { return CHyprColor(0, 0, 0, 0); })
-                        ->size(CDynamicSize(CDynamicSize::HT_SIZE_ABSOLUTE,
-                                            CDynamicSize::HT_SIZE_ABSOLUTE,
-                                            {ITEM_WIDTH, ITEM_HEIGHT}))
-                        ->commence();
-                    rowLayout->addChild(empty);
-                    continue;
-                }
-                
-                const auto& wallpaper = wallpapers[index];
-                size_t itemIndex = m_gridItems.size(); // Current size before adding
-                
-                // Create callbacks for this specific item
-                auto onHover = [this, itemIndex]() {
-                    selectItem(itemIndex);
-                };
-                
-                auto onClick = [this, itemIndex]() {
-                    selectItem(itemIndex);
-                    selectCurrentWallpaper();
-                };
-                
-                auto gridItem = std::make_shared<GridWallpaperItem>(wallpaper, m_backend, onHover, onClick);
-                if (gridItem->getElement()) {
-                    rowLayout->addChild(gridItem->getElement());
-                    m_gridItems.push_back(gridItem);
-                    
-                    // Initially all items are visible
-                    m_visibleItems.push_back(itemIndex);
-                }
-            }
+            auto onClick = [this](size_t wallpaper) {
+                app.selectItem(wallpaper);
+                app.selectCurrentWallpaper();
+            };
             
-            m_gridLayout->addChild(rowLayout);
+            auto gridItem = std::make_shared<GridWallpaperItem>(app.m_wallpaperDatabase->getAllWallpapers()[index],
+                                                                index, app.m_backend, onHover, onClick);
+            return gridItem->getElement() ? gridItem : nullptr;
         }
         
-        m_gridContainer->addChild(m_gridLayout);
-        m_scrollArea->addChild(m_gridContainer);
+        void bindCell(const CellPtr& gridItem, size_t index) {
+            gridItem->bind(index, app.m_wallpaperDatabase->getAllWallpapers()[index]);
+        }
         
-        // Select first item
-        if (!m_gridItems.empty()) {
-            selectFirstVisibleItem();
+        void placeCell(const CellPtr& gridItem, size_t index) {
+            gridItem->setVisible(app.m_shown[index] != 0);
+            gridItem->setActive(index == app.m_selectedIndex);
+            
+            auto element = gridItem->getElement();
+            element->setPositionMode(IElement::HT_POSITION_ABSOLUTE);
+            element->setAbsolutePosition({(ITEM_WIDTH + COLUMN_GAP) * static_cast<float>(index % COLUMN_COUNT),
+                                          (ITEM_HEIGHT + ROW_GAP) * static_cast<float>(index / COLUMN_COUNT)});
+            app.m_gridContainer->addChild(element);
+        }
+        
+        void removeCell(const CellPtr& gridItem) {
+            app.m_gridContainer->removeChild(gridItem->getElement());
+        }
+    };
+    
+    // Applies to the item of `index`, if it has one
+    void setItemActive(size_t index, bool active) {
+        if (auto gridItem = m_cells.cell(index)) {
+            gridItem->setActive(active);
         }
     }
     
     void filterItems(const std::string& filter) {
         if (!m_searchBox) return;
         
-        std::string lowercaseFilter = filter;
-        std::transform(lowercaseFilter.begin(), lowercaseFilter.end(), 
-                      lowercaseFilter.begin(), ::tolower);
+        // Answered through showFilterResults() once the worker is done
+        m_filterWorker->submit(filter);
+    }
+    
+    // Runs on the filter worker's thread
+    void searchItems(const std::string& filter, const CancelToken& cancel, std::vector<size_t>& out) {
+        SearchKey::assign(filter, m_filterKey);
+        
+        // A longer query can only narrow the previous matches, and backspace
+        // returns to matches that were already computed
+        auto [candidates, exact] = m_filterStack.lookup(m_filterKey);
+        if (exact) {
+            out.assign(candidates->begin(), candidates->end());
+            return;
+        }
         
-        // Clear visible items
-        m_visibleItems.clear();
+        std::vector<size_t>& results = m_filterStack.push(m_filterKey);
+        if (candidates) {
+            m_searchKeys.refine(m_filterKey, *candidates, results, cancel);
+        } else {
+            m_searchKeys.find(m_filterKey, results, cancel);
+        }
         
-        // Filter items
-        for (size_t i = 0; i < m_gridItems.size(); ++i) {
-            bool visible = m_gridItems[i]->matchesFilter(lowercaseFilter);
-            m_gridItems[i]->setVisible(visible);
-            
-            if (visible) {
-                m_visibleItems.push_back(i);
-            }
+        if (cancel.cancelled()) {
+            // A partial set must not be refined later
+            m_filterStack.pop();
+            return;
         }
+        out.assign(results.begin(), results.end());
+    }
+    
+    void showFilterResults(const std::vector<size_t>& matches) {
+        updateVisibility(matches);
         
         // Update status text
         if (auto builder = m_statusText->rebuild()) {
             builder->text(std::string{"Showing " + std::to_string(m_visibleItems.size()) + 
-                                      " of " + std::to_string(m_gridItems.size()) + 
+                                      " of " + std::to_string(m_cells.count()) + 
                                       " wallpapers"})
                    ->commence();
         }
@@ -648,39 +721,61 @@ class ThemeApp {
         if (!m_visibleItems.empty()) {
             selectFirstVisibleItem();
         } else {
-            m_selectedIndex = 0;
-            for (auto& item : m_gridItems) {
-                item->setActive(false);
+            setItemActive(m_selectedIndex, false);
+            m_selectedIndex = NO_SELECTION;
+        }
+    }
+    
+    // Show and hide only the items whose visibility changed. Both lists are
+    // in ascending order, so one merge pass finds them. Wallpapers without
+    // an item only have their flag in m_shown updated.
+    void updateVisibility(const std::vector<size_t>& visible) {
+        auto oldIt = m_visibleItems.begin();
+        auto newIt = visible.begin();
+        
+        while (oldIt != m_visibleItems.end() || newIt != visible.end()) {
+            if (newIt == visible.end() || (oldIt != m_visibleItems.end() && *oldIt < *newIt)) {
+                setShown(*oldIt++, false);
+            } else if (oldIt == m_visibleItems.end() || *newIt < *oldIt) {
+                setShown(*newIt++, true);
+            } else {
+                ++oldIt;
+                ++newIt;
             }
         }
+        
+        m_visibleItems = visible;
+    }
+    
+    void setShown(size_t index, bool shown) {
+        m_shown[index] = shown;
+        if (auto gridItem = m_cells.cell(index)) {
+            gridItem->setVisible(shown);
+        }
     }
     
     void selectFirstVisibleItem() {
         if (m_visibleItems.empty()) return;
         
         // Deselect current item
-        if (m_selectedIndex < m_gridItems.size() && m_gridItems[m_selectedIndex]->isActive()) {
-            m_gridItems[m_selectedIndex]->setActive(false);
-        }
+        setItemActive(m_selectedIndex, false);
         
         // Select first visible
         m_selectedIndex = m_visibleItems[0];
-        m_gridItems[m_selectedIndex]->setActive(true);
+        setItemActive(m_selectedIndex, true);
         updateGridPosition();
         ensureSelectionVisible();
     }
     
     void selectItem(size_t index) {
-        if (index >= m_gridItems.size()) return;
+        if (index >= m_cells.count()) return;
         
         // Deselect current item
-        if (m_selectedIndex < m_gridItems.size()) {
-            m_gridItems[m_selectedIndex]->setActive(false);
-        }
+        setItemActive(m_selectedIndex, false);
         
         // Select new item
         m_selectedIndex = index;
-        m_gridItems[m_selectedIndex]->setActive(true);
+        setItemActive(m_selectedIndex, true);
         
         // Update grid position
         updateGridPosition();
@@ -690,9 +785,8 @@ class ThemeApp {
     }
     
     void updateGridPosition() {
-        if (m_gridItems.empty()) return;
+        if (m_selectedIndex >= m_cells.count()) return;
         
-        const int COLUMN_COUNT = 4;
         m_gridRow = m_selectedIndex / COLUMN_COUNT;
         m_gridCol = m_selectedIndex % COLUMN_COUNT;
     }
@@ -715,7 +809,6 @@ class ThemeApp {
     // Move within visible items
     if (deltaRow != 0) {
         // For row navigation in grid, we need to consider columns
-        const int COLUMN_COUNT = 4;
         int currentRow = static_cast<int>(m_selectedIndex) / COLUMN_COUNT;
         int currentCol = static_cast<int>(m_selectedIndex) % COLUMN_COUNT;
         
@@ -723,11 +816,11 @@ class ThemeApp {
         
         // Find first visible item in the target row
         int newIndex = -1;
-        for (size_t i = 0; i < m_gridItems.size(); ++i) {
+        for (size_t i = 0; i < m_cells.count(); ++i) {
             int row = static_cast<int>(i) / COLUMN_COUNT;
             int col = static_cast<int>(i) % COLUMN_COUNT;
             
-            if (row == newRow && m_gridItems[i]->isVisible()) {
+            if (row == newRow && m_shown[i]) {
                 // Prefer same column if available
                 if (col == currentCol) {
                     newIndex = static_cast<int>(i);
@@ -744,7 +837,6 @@ class ThemeApp {
         }
     } else if (deltaCol != 0) {
         // Move left/right within same row, considering visibility
-        const int COLUMN_COUNT = 4;
         int currentRow = static_cast<int>(m_selectedIndex) / COLUMN_COUNT;
         int currentCol = static_cast<int>(m_selectedIndex) % COLUMN_COUNT;
         
@@ -753,7 +845,7 @@ class ThemeApp {
         // Try to stay in same row first
         while (newCol >= 0 && newCol < COLUMN_COUNT) {
             size_t potentialIndex = currentRow * COLUMN_COUNT + newCol;
-            if (potentialIndex < m_gridItems.size() && m_gridItems[potentialIndex]->isVisible()) {
+            if (potentialIndex < m_cells.count() && m_shown[potentialIndex]) {
                 selectItem(potentialIndex);
                 return;
             }
@@ -794,11 +886,9 @@ class ThemeApp {
     
     
     void ensureSelectionVisible() {
-        if (m_gridItems.empty() || !m_scrollArea) return;
+        if (m_cells.count() == 0 || !m_scrollArea) return;
         
         // Grid view scrolling
-        const float ITEM_HEIGHT = 180.0F;
-        const float ROW_GAP = 10.0F;
         const float ROW_HEIGHT = ITEM_HEIGHT + ROW_GAP;
         const float SCROLL_AREA_HEIGHT = m_scrollArea->size().y;
         const float CURRENT_SCROLL = m_scrollArea->getCurrentScroll().y;
@@ -811,13 +901,17 @@ class ThemeApp {
         } else if (SELECTION_BOTTOM > CURRENT_SCROLL + SCROLL_AREA_HEIGHT) {
             m_scrollArea->setScroll({0.F, SELECTION_BOTTOM - SCROLL_AREA_HEIGHT});
         }
+        
+        // Place the items of the rows scrolled to before the next frame
+        syncViewport();
     }
     
     void selectCurrentWallpaper() {
-        if (m_selectedIndex >= m_gridItems.size()) return;
+        if (m_selectedIndex >= m_cells.count()) return;
         
-        std::cout << "Selecting wallpaper: " << m_gridItems[m_selectedIndex]->getWallpaper().filename << std::endl;
-        m_gridItems[m_selectedIndex]->select();
+        const auto& wallpaper = m_wallpaperDatabase->getAllWallpapers()[m_selectedIndex];
+        std::cout << "Selecting wallpaper: " << wallpaper.filename << std::endl;
+        GridWallpaperItem::select(wallpaper);
     }
     
     void closeApp() {
@@ -905,12 +999,32 @@ class ThemeApp {
     CSharedPointer<CTextElement> m_statusText;
     CSharedPointer<CScrollAreaElement> m_scrollArea;
     CSharedPointer<CRectangleElement> m_gridContainer;
-    CSharedPointer<CColumnLayoutElement> m_gridLayout;
+    
+    // Hardcoded grid configuration
+    static constexpr int COLUMN_COUNT = 4;
+    static constexpr float ITEM_WIDTH = 180.0F;
+    static constexpr float ITEM_HEIGHT = 180.0F;
+    static constexpr float ROW_GAP = 10.0F;
+    static constexpr float COLUMN_GAP = 10.0F;
+    // Until the scroll area has been laid out and knows its own
+    static constexpr float DEFAULT_SCROLL_HEIGHT = 500.F;
+    static constexpr size_t NO_SELECTION = SIZE_MAX;
     
     std::unique_ptr<WallpaperDatabase> m_wallpaperDatabase;
-    std::vector<std::shared_ptr<GridWallpaperItem>> m_gridItems;
+    // Items for the rows in view, indexed like the wallpapers
+    CellHost m_cellHost{*this};
+    VirtualGrid<CellHost> m_cells{m_cellHost};
+    bool m_viewportSyncQueued = false;
     
     std::vector<size_t> m_visibleItems; // Indices of visible items
+    std::vector<uint8_t> m_shown; // Per wallpaper, whether it is in m_visibleItems
+    
+    // Owned by the filter worker's thread; the UI pauses it to rebuild them
+    RefinementStack<size_t> m_filterStack; // Matches of the queries typed so far
+    std::string m_filterKey; // SearchKey of the current filter text
+    IndexedKeys m_searchKeys; // Filename keys, indexed like the wallpapers
+    // Declared after what it searches, so it stops before they are destroyed
+    std::unique_ptr<SearchWorker<std::vector<size_t>>> m_filterWorker;
     
     size_t m_selectedIndex = 0;
     size_t m_gridRow = 0;